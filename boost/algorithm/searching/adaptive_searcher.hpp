@@ -0,0 +1,456 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_ADAPTIVE_SEARCHER_HPP
+#define BOOST_ALGORITHM_ADAPTIVE_SEARCHER_HPP
+
+#include <algorithm>    // for std::search
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits, std::distance
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/variant/variant.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/tr1/tr1/unordered_set>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/two_way.hpp>
+#include <boost/algorithm/searching/shift_or.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A searcher which picks the algorithm to use from the pattern.
+
+    Which of the searchers is fastest depends on the pattern: its length, how
+    many different elements are in it, and whether it is periodic (like "abcabcab").
+    make_searcher looks at the pattern once, when the searcher is built, and
+    chooses an engine from a searcher_tuning table:
+
+        * Very short patterns in text use std::search; building tables doesn't pay.
+        * Highly periodic patterns use a linear-time engine (two_way, by default).
+        * Otherwise, the engine comes from a table indexed by the length of the
+          pattern and the size of its alphabet (small, like DNA, or large, like text).
+
+    The defaults are reasonable for byte searches on common hardware; the
+    search_benchmark example can write a table calibrated for the local machine
+    (see its --tuning option), which can be read back with operator >>.
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types must "point to" the same underlying type.
+        * The requirements of all the engines (the elements must be hashable)
+*/
+
+    enum searcher_engine {
+        std_search_engine,
+        boyer_moore_engine,
+        boyer_moore_horspool_engine,
+        knuth_morris_pratt_engine,
+        two_way_engine,
+        shift_or_engine
+        };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    inline const char *engine_name ( searcher_engine e ) {
+        static const char *k_names [] = {
+            "std_search", "boyer_moore", "boyer_moore_horspool", "knuth_morris_pratt", "two_way", "shift_or" };
+        return k_names [ e ];
+        }
+
+    inline bool engine_from_name ( const std::string &name, searcher_engine &e ) {
+        for ( int i = std_search_engine; i <= shift_or_engine; ++i )
+            if ( name == engine_name ( static_cast<searcher_engine> ( i ))) {
+                e = static_cast<searcher_engine> ( i );
+                return true;
+                }
+        return false;
+        }
+
+//  std::search, with the same interface as the searcher objects
+    template <typename patIter>
+    class std_searcher {
+    public:
+        std_searcher ( patIter first, patIter last ) : pat_first ( first ), pat_last ( last ) {}
+
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            return std::search ( corpus_first, corpus_last, pat_first, pat_last );
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) {            // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+            const typename std::iterator_traits<corpusIter>::difference_type
+                k_pattern_length = std::distance ( pat_first, pat_last );
+            corpusIter curPos = corpus_first;
+            while (( curPos = std::search ( curPos, corpus_last, pat_first, pat_last )) != corpus_last ) {
+                *out++ = curPos;
+                if ( overlapping )
+                    ++curPos;
+                else if ( std::distance ( curPos, corpus_last ) > k_pattern_length )
+                    curPos += k_pattern_length;
+                else
+                    break;
+                }
+            return out;
+            }
+
+    private:
+        patIter pat_first, pat_last;
+        };
+
+//  Count the different elements; bytes with a table, anything else with a hash set
+    template <typename patIter>
+    std::size_t count_distinct ( patIter first, patIter last, boost::true_type ) {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename boost::make_unsigned<value_type>::type unsigned_type;
+        bool seen [ 256 ] = { false };
+        std::size_t retVal = 0;
+        for ( ; first != last; ++first ) {
+            bool &s = seen [ static_cast<unsigned_type> ( *first ) ];
+            retVal += !s;
+            s = true;
+            }
+        return retVal;
+        }
+
+    template <typename patIter>
+    std::size_t count_distinct ( patIter first, patIter last, boost::false_type ) {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        std::tr1::unordered_set<value_type> seen ( first, last );
+        return seen.size ();
+        }
+}
+/// \endcond
+
+    /// \brief What make_searcher knows about a pattern
+    struct pattern_profile {
+        std::size_t length;
+        std::size_t distinct;   // the number of different elements in the pattern
+        std::size_t period;     // the smallest p such that pattern[i] == pattern[i+p]; length if none
+        };
+
+/// \fn profile_pattern ( patIter first, patIter last )
+/// \brief Measures the pattern's length, alphabet and period
+///
+/// \param first    The start of the pattern (Random Access Iterator)
+/// \param last     One past the end of the pattern
+///
+    template <typename patIter>
+    pattern_profile profile_pattern ( patIter first, patIter last ) {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+
+        pattern_profile retVal;
+        retVal.length = std::distance ( first, last );
+        retVal.distinct = detail::count_distinct ( first, last,
+                boost::integral_constant<bool, boost::is_integral<value_type>::value && sizeof ( value_type ) == 1> ());
+        retVal.period = retVal.length;
+
+    //  The period is the length, less the longest proper border (from the KMP prefix function)
+        if ( retVal.length > 0 ) {
+            std::vector<difference_type> border ( retVal.length, 0 );
+            difference_type k = 0;
+            for ( std::size_t i = 1; i < retVal.length; ++i ) {
+                while ( k > 0 && !( first [ k ] == first [ i ] ))
+                    k = border [ k - 1 ];
+                if ( first [ k ] == first [ i ] )
+                    ++k;
+                border [ i ] = k;
+                }
+            retVal.period = retVal.length - border [ retVal.length - 1 ];
+            }
+        return retVal;
+        }
+
+    template <typename Range>
+    pattern_profile profile_pattern ( const Range &r ) {
+        return profile_pattern ( boost::begin ( r ), boost::end ( r ));
+        }
+
+
+    /// \brief The table that make_searcher uses to choose an engine
+    struct searcher_tuning {
+        BOOST_STATIC_CONSTANT ( std::size_t, k_length_classes = 4 );
+        BOOST_STATIC_CONSTANT ( std::size_t, k_alphabet_classes = 2 );  // small, large
+
+        std::size_t length_limit [ k_length_classes - 1 ];  // the longest pattern in each length class
+        std::size_t small_alphabet;     // at most this many different elements is a "small" alphabet
+        std::size_t periodic_divisor;   // periodic if period * periodic_divisor <= length; 0 to disable
+        searcher_engine periodic_engine;
+        searcher_engine engines [ k_alphabet_classes ][ k_length_classes ];
+
+        searcher_tuning () : small_alphabet ( 4 ), periodic_divisor ( 4 ), periodic_engine ( two_way_engine ) {
+            length_limit [ 0 ] =  4;
+            length_limit [ 1 ] = 16;
+            length_limit [ 2 ] = 64;
+
+        //  With a small alphabet the skips are short, and the bit-parallel searcher wins
+            engines [ 0 ][ 0 ] = shift_or_engine;
+            engines [ 0 ][ 1 ] = shift_or_engine;
+            engines [ 0 ][ 2 ] = shift_or_engine;
+            engines [ 0 ][ 3 ] = shift_or_engine;
+            engines [ 1 ][ 0 ] = std_search_engine;
+            engines [ 1 ][ 1 ] = boyer_moore_horspool_engine;
+            engines [ 1 ][ 2 ] = boyer_moore_horspool_engine;
+            engines [ 1 ][ 3 ] = boyer_moore_engine;
+            }
+
+        std::size_t length_class ( std::size_t length ) const {
+            std::size_t retVal = 0;
+            while ( retVal < k_length_classes - 1 && length > length_limit [ retVal ] )
+                ++retVal;
+            return retVal;
+            }
+
+    //  A pattern with no repeated elements says nothing about the alphabet; it is never "small"
+        std::size_t alphabet_class ( const pattern_profile &p ) const {
+            return p.distinct <= small_alphabet && p.distinct < p.length ? 0 : 1;
+            }
+
+        searcher_engine choose ( const pattern_profile &p ) const {
+            if ( p.length > length_limit [ 0 ] && periodic_divisor != 0 && p.period * periodic_divisor <= p.length )
+                return periodic_engine;
+            return engines [ alphabet_class ( p ) ][ length_class ( p.length ) ];
+            }
+        };
+
+//  The tuning table as text, one setting per line:
+//      length_limits 4 16 64
+//      small_alphabet 4
+//      periodic_divisor 4
+//      periodic_engine two_way
+//      small_alphabet_engines shift_or shift_or shift_or shift_or
+//      large_alphabet_engines std_search boyer_moore_horspool boyer_moore_horspool boyer_moore
+//  When reading, settings that are missing keep their current values; an unknown setting
+//  or engine sets failbit.
+    template <typename charT, typename traits>
+    std::basic_ostream<charT, traits> &operator << ( std::basic_ostream<charT, traits> &os, const searcher_tuning &t ) {
+        os << "length_limits";
+        for ( std::size_t i = 0; i < searcher_tuning::k_length_classes - 1; ++i )
+            os << ' ' << t.length_limit [ i ];
+        os << "\nsmall_alphabet "   << t.small_alphabet
+           << "\nperiodic_divisor " << t.periodic_divisor
+           << "\nperiodic_engine "  << detail::engine_name ( t.periodic_engine );
+        for ( std::size_t a = 0; a < searcher_tuning::k_alphabet_classes; ++a ) {
+            os << ( a == 0 ? "\nsmall_alphabet_engines" : "\nlarge_alphabet_engines" );
+            for ( std::size_t i = 0; i < searcher_tuning::k_length_classes; ++i )
+                os << ' ' << detail::engine_name ( t.engines [ a ][ i ] );
+            }
+        return os << '\n';
+        }
+
+    template <typename charT, typename traits>
+    std::basic_istream<charT, traits> &operator >> ( std::basic_istream<charT, traits> &is, searcher_tuning &t ) {
+        searcher_tuning retVal ( t );
+        std::string key, name;
+        while ( is >> key ) {
+            if ( key == "length_limits" ) {
+                for ( std::size_t i = 0; i < searcher_tuning::k_length_classes - 1; ++i )
+                    is >> retVal.length_limit [ i ];
+                }
+            else if ( key == "small_alphabet" )
+                is >> retVal.small_alphabet;
+            else if ( key == "periodic_divisor" )
+                is >> retVal.periodic_divisor;
+            else if ( key == "periodic_engine" ) {
+                if ( !( is >> name ) || !detail::engine_from_name ( name, retVal.periodic_engine ))
+                    is.setstate ( std::ios_base::failbit );
+                }
+            else if ( key == "small_alphabet_engines" || key == "large_alphabet_engines" ) {
+                const std::size_t a = key [ 0 ] == 's' ? 0 : 1;
+                for ( std::size_t i = 0; i < searcher_tuning::k_length_classes; ++i )
+                    if ( !( is >> name ) || !detail::engine_from_name ( name, retVal.engines [ a ][ i ] )) {
+                        is.setstate ( std::ios_base::failbit );
+                        break;
+                        }
+                }
+            else
+                is.setstate ( std::ios_base::failbit );
+            if ( is.fail ())
+                return is;
+            }
+
+    //  Reading up to the end of the stream is success
+        if ( is.eof ()) {
+            is.clear ( std::ios_base::eofbit );
+            t = retVal;
+            }
+        return is;
+        }
+
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    template <typename corpusIter>
+    struct adaptive_search_visitor : public boost::static_visitor<corpusIter> {
+        adaptive_search_visitor ( corpusIter first, corpusIter last ) : corpus_first ( first ), corpus_last ( last ) {}
+
+        template <typename Searcher>
+        corpusIter operator () ( const Searcher &s ) const { return s ( corpus_first, corpus_last ); }
+
+        corpusIter corpus_first, corpus_last;
+        };
+
+    template <typename corpusIter, typename OutputIterator>
+    struct adaptive_find_all_visitor : public boost::static_visitor<OutputIterator> {
+        adaptive_find_all_visitor ( corpusIter first, corpusIter last, OutputIterator o, bool overlap )
+            : corpus_first ( first ), corpus_last ( last ), out ( o ), overlapping ( overlap ) {}
+
+        template <typename Searcher>
+        OutputIterator operator () ( const Searcher &s ) const {
+            return s.find_all ( corpus_first, corpus_last, out, overlapping );
+            }
+
+        corpusIter corpus_first, corpus_last;
+        OutputIterator out;
+        bool overlapping;
+        };
+}
+/// \endcond
+
+    template <typename patIter>
+    class adaptive_searcher {
+        typedef boost::variant<
+                    detail::std_searcher<patIter>,
+                    boyer_moore<patIter>,
+                    boyer_moore_horspool<patIter>,
+                    knuth_morris_pratt<patIter>,
+                    two_way<patIter>,
+                    shift_or<patIter> > engine_type;
+    public:
+        adaptive_searcher ( patIter first, patIter last, const searcher_tuning &tuning = searcher_tuning ())
+            : profile_ ( profile_pattern ( first, last )),
+              engine_  ( tuning.choose ( profile_ )),
+              searcher_ ( make_engine ( first, last, engine_ )) {}
+
+        ~adaptive_searcher () {}
+
+        /// \fn engine () const
+        /// \brief Returns the engine that was chosen for the pattern
+        searcher_engine engine () const { return engine_; }
+
+        /// \fn profile () const
+        /// \brief Returns what was learned about the pattern
+        const pattern_profile &profile () const { return profile_; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            detail::adaptive_search_visitor<corpusIter> v ( corpus_first, corpus_last );
+            return boost::apply_visitor ( v, searcher_ );
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            detail::adaptive_find_all_visitor<corpusIter, OutputIterator> v ( corpus_first, corpus_last, out, overlapping );
+            return boost::apply_visitor ( v, searcher_ );
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        pattern_profile profile_;
+        searcher_engine engine_;
+        engine_type searcher_;
+
+        static engine_type make_engine ( patIter first, patIter last, searcher_engine e ) {
+            switch ( e ) {
+                case boyer_moore_engine:          return engine_type ( boyer_moore<patIter> ( first, last ));
+                case boyer_moore_horspool_engine: return engine_type ( boyer_moore_horspool<patIter> ( first, last ));
+                case knuth_morris_pratt_engine:   return engine_type ( knuth_morris_pratt<patIter> ( first, last ));
+                case two_way_engine:              return engine_type ( two_way<patIter> ( first, last ));
+                case shift_or_engine:             return engine_type ( shift_or<patIter> ( first, last ));
+                default:                          break;
+                }
+            return engine_type ( detail::std_searcher<patIter> ( first, last ));
+            }
+/// \endcond
+        };
+
+
+/// \fn make_searcher ( patIter pat_first, patIter pat_last, const searcher_tuning &tuning )
+/// \brief Builds a searcher for the pattern, using the engine that suits it best
+///
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the pattern
+/// \param tuning       The table used to choose the engine
+///
+    template <typename patIter>
+    adaptive_searcher<patIter> make_searcher ( patIter pat_first, patIter pat_last,
+                                    const searcher_tuning &tuning = searcher_tuning ()) {
+        return adaptive_searcher<patIter> ( pat_first, pat_last, tuning );
+        }
+
+    template <typename Range>
+    adaptive_searcher<typename boost::range_iterator<const Range>::type>
+    make_searcher ( const Range &r, const searcher_tuning &tuning = searcher_tuning ()) {
+        return adaptive_searcher
+            <typename boost::range_iterator<const Range>::type> ( boost::begin ( r ), boost::end ( r ), tuning );
+        }
+
+    template <typename Range>
+    adaptive_searcher<typename boost::range_iterator<Range>::type>
+    make_searcher ( Range &r, const searcher_tuning &tuning = searcher_tuning ()) {
+        return adaptive_searcher
+            <typename boost::range_iterator<Range>::type> ( boost::begin ( r ), boost::end ( r ), tuning );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_ADAPTIVE_SEARCHER_HPP
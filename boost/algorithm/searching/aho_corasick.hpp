@@ -0,0 +1,298 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_AHO_CORASICK_SEARCH_HPP
+#define BOOST_ALGORITHM_AHO_CORASICK_SEARCH_HPP
+
+#include <vector>
+#include <utility>      // for std::pair
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/detail/ac_traits.hpp>
+#include <boost/algorithm/searching/detail/debugging.hpp>
+
+// #define  BOOST_ALGORITHM_AHO_CORASICK_DEBUG
+
+namespace boost { namespace algorithm {
+
+/*
+    A templated version of the Aho-Corasick multiple pattern searching algorithm.
+
+    The searcher is built from a sequence of patterns, and finds all of them
+    in a single pass over the corpus. Each match is reported as the index of
+    the pattern (its position in the sequence that was passed to the constructor)
+    and an iterator to the start of the match in the corpus.
+
+    The patterns are copied into the automaton; they do not have to outlive the searcher.
+
+    The automaton has one state per distinct prefix of the patterns, so at most
+    one more than their total length. For bytes, each state has a row with one
+    transition for each value that appears in the patterns, plus one shared by
+    all the values that don't; that is (distinct values + 1) * sizeof(state_type)
+    bytes per state, where state_type is 32 bits. 2,000 patterns of 30 bytes drawn
+    from 64 distinct values take at most 60,001 states * 65 * 4 bytes, or about
+    15MB; patterns that use every byte value take about 1K per state. Other
+    element types keep just the edges of the trie, about sizeof(element) +
+    sizeof(state_type) bytes each, plus the failure links.
+
+    Requirements:
+        * Random access iterators for the corpus
+        * The elements of the patterns and the corpus must be the same type
+        * Additional requirements may be imposed by the transition table, such as:
+        ** Numeric type (array-based transition table)
+        ** Ordered type; operator < (compressed transition table)
+
+    http://en.wikipedia.org/wiki/Aho–Corasick_string_matching_algorithm
+    http://cr.yp.to/bib/1975/aho.pdf
+*/
+
+    template <typename key_type, typename traits = detail::AC_traits<key_type> >
+    class aho_corasick {
+        typedef typename traits::state_type state_type;
+    public:
+        typedef std::size_t pattern_id;
+
+        /// \fn aho_corasick ( Iter patterns_first, Iter patterns_last )
+        /// \brief Builds the automaton for a sequence of patterns
+        ///
+        /// \param patterns_first The start of the patterns; each pattern is a range
+        /// \param patterns_last  One past the end of the patterns
+        ///
+        template <typename Iter>
+        aho_corasick ( Iter patterns_first, Iter patterns_last )
+                : pattern_count_ ( 0 ), min_length_ ( 0 ) {
+            BOOST_STATIC_ASSERT (( boost::is_same<key_type,
+                typename boost::range_value<typename std::iterator_traits<Iter>::value_type>::type>::value ));
+
+            trie_type trie ( 1 );       // just the root
+            for ( ; patterns_first != patterns_last; ++patterns_first )
+                this->add_pattern ( trie, boost::begin ( *patterns_first ), boost::end ( *patterns_first ));
+            this->build_automaton ( trie );
+#ifdef BOOST_ALGORITHM_AHO_CORASICK_DEBUG
+            table_.PrintTransitionTable ();
+#endif
+            }
+
+        ~aho_corasick () {}
+
+        /// \fn pattern_count () const
+        /// \brief Returns the number of patterns that the searcher looks for
+        std::size_t pattern_count () const { return pattern_count_; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the first occurrence of any of the patterns
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        /// Returns an iterator to the start of the match that ends first in the corpus
+        /// (if several matches end at the same place, the longest one), or corpus_last.
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<key_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( pattern_count_ == 0 )         return corpus_last;  // nothing to look for
+            if ( min_length_ == 0 )            return corpus_first; // empty pattern matches at start
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+
+            state_type s = 0;
+            for ( corpusIter curPos = corpus_first; curPos != corpus_last; ++curPos ) {
+                s = table_.next ( s, *curPos );
+                const state_type r = report_ [ s ];
+                if ( r != k_no_state )
+                    return curPos + 1 - length_ [ output_ [ r ]];
+                }
+            return corpus_last;
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out )
+        /// \brief Searches the corpus for every occurrence of all of the patterns
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives a std::pair<pattern_id, corpusIter>
+        ///                     for each match
+        ///
+        /// The matches are reported in order of where they end in the corpus,
+        /// longest first when several end at the same place.
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<key_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+        //  Empty patterns are reported once, at the start of the corpus
+            if ( corpus_first != corpus_last )
+                for ( pattern_id id = output_ [ 0 ]; id != k_no_pattern; id = same_ [ id ] )
+                    *out++ = std::make_pair ( id, corpus_first );
+
+            state_type s = 0;
+            for ( corpusIter curPos = corpus_first; curPos != corpus_last; ++curPos ) {
+                s = table_.next ( s, *curPos );
+                if ( report_ [ s ] != k_no_state )
+                    out = this->report ( s, curPos + 1, out );
+                }
+            return out;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        typedef std::vector<std::pair<key_type, state_type> > edge_list;
+        typedef std::vector<edge_list> trie_type;
+        BOOST_STATIC_CONSTANT ( state_type, k_no_state = static_cast<state_type> ( -1 ));
+        BOOST_STATIC_CONSTANT ( pattern_id, k_no_pattern = static_cast<pattern_id> ( -1 ));
+
+        typename traits::transition_table_t table_;
+        std::vector<pattern_id>   output_;      // the first pattern that ends at each state
+        std::vector<state_type>   report_;      // the first state on the failure chain with an output
+        std::vector<state_type>   dict_;        // the next state after this one on the failure chain with an output
+        std::vector<std::size_t>  length_;      // the length of each pattern
+        std::vector<pattern_id>   same_;        // the next pattern with the same contents
+        std::size_t pattern_count_;
+        std::size_t min_length_;
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator report ( state_type s, corpusIter match_end, OutputIterator out ) const {
+            for ( state_type r = report_ [ s ]; r != k_no_state; r = dict_ [ r ] )
+                for ( pattern_id id = output_ [ r ]; id != k_no_pattern; id = same_ [ id ] )
+                    *out++ = std::make_pair ( id, match_end - length_ [ id ] );
+            return out;
+            }
+
+        template <typename patIter>
+        void add_pattern ( trie_type &trie, patIter first, patIter last ) {
+            state_type s = 0;
+            std::size_t length = 0;
+            for ( ; first != last; ++first, ++length ) {
+                typename edge_list::const_iterator it = trie [ s ].begin ();
+                while ( it != trie [ s ].end () && !( it->first == *first ))
+                    ++it;
+                if ( it != trie [ s ].end ())
+                    s = it->second;
+                else {
+                    const state_type child = static_cast<state_type> ( trie.size ());
+                    trie [ s ].push_back ( std::make_pair ( *first, child ));
+                    trie.push_back ( edge_list ());
+                    s = child;
+                    }
+                }
+
+            if ( output_.size () < trie.size ())
+                output_.resize ( trie.size (), k_no_pattern );
+        //  Patterns with the same contents end at the same state; chain them together
+            const pattern_id id = pattern_count_++;
+            length_.push_back ( length );
+            same_.push_back ( k_no_pattern );
+            if ( output_ [ s ] == k_no_pattern )
+                output_ [ s ] = id;
+            else {
+                pattern_id p = output_ [ s ];
+                while ( same_ [ p ] != k_no_pattern )
+                    p = same_ [ p ];
+                same_ [ p ] = id;
+                }
+            if ( id == 0 || length < min_length_ )
+                min_length_ = length;
+            }
+
+    //  Compute the failure links in breadth-first order, then hand the trie to the transition table
+        void build_automaton ( const trie_type &trie ) {
+            const std::size_t count = trie.size ();
+            output_.resize ( count, k_no_pattern );
+            std::vector<state_type> fail ( count, 0 );
+            std::vector<state_type> order;
+            order.reserve ( count );
+            report_.assign ( count, k_no_state );
+            dict_.assign ( count, k_no_state );
+
+            order.push_back ( 0 );
+            for ( std::size_t i = 0; i < order.size (); ++i ) {
+                const state_type s = order [ i ];
+                for ( typename edge_list::const_iterator e = trie [ s ].begin (); e != trie [ s ].end (); ++e ) {
+                    const state_type child = e->second;
+                    if ( s != 0 ) {
+                        state_type f = fail [ s ];
+                        state_type next;
+                        while (( next = this->goto_state ( trie, f, e->first )) == k_no_state && f != 0 )
+                            f = fail [ f ];
+                        fail [ child ] = next == k_no_state ? 0 : next;
+                        }
+                    order.push_back ( child );
+                    }
+
+            //  The root only holds empty patterns, which aren't reported during the scan
+                if ( s != 0 ) {
+                    dict_ [ s ] = report_ [ fail [ s ]];
+                    report_ [ s ] = output_ [ s ] != k_no_pattern ? s : dict_ [ s ];
+                    }
+                }
+
+            table_.build ( trie, fail, order );
+            }
+
+        state_type goto_state ( const trie_type &trie, state_type s, const key_type &key ) const {
+            for ( typename edge_list::const_iterator it = trie [ s ].begin (); it != trie [ s ].end (); ++it )
+                if ( it->first == key )
+                    return it->second;
+            return k_no_state;
+            }
+/// \endcond
+        };
+
+
+/// \cond DOXYGEN_HIDE
+    template <typename key_type, typename traits>
+    const typename aho_corasick<key_type, traits>::state_type aho_corasick<key_type, traits>::k_no_state;
+
+    template <typename key_type, typename traits>
+    const typename aho_corasick<key_type, traits>::pattern_id aho_corasick<key_type, traits>::k_no_pattern;
+/// \endcond
+
+
+/// \fn aho_corasick_find_all ( corpusIter corpus_first, corpusIter corpus_last,
+///       const PatternRanges &patterns, OutputIterator out )
+/// \brief Searches the corpus for every occurrence of all of the patterns.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param patterns     A range of patterns to search for
+/// \param out          An output iterator which receives a std::pair<std::size_t, corpusIter>
+///                     (the index of the pattern and the start of the match) for each match
+///
+    template <typename PatternRanges, typename corpusIter, typename OutputIterator>
+    OutputIterator aho_corasick_find_all (
+            corpusIter corpus_first, corpusIter corpus_last,
+            const PatternRanges &patterns, OutputIterator out ) {
+        aho_corasick<typename std::iterator_traits<corpusIter>::value_type> ac
+                ( boost::begin ( patterns ), boost::end ( patterns ));
+        return ac.find_all ( corpus_first, corpus_last, out );
+        }
+
+    //  Creator function -- take a range of patterns, return an object
+    template <typename PatternRanges>
+    boost::algorithm::aho_corasick<typename boost::range_value<
+                typename boost::range_value<const PatternRanges>::type>::type>
+    make_aho_corasick ( const PatternRanges &patterns ) {
+        return boost::algorithm::aho_corasick<typename boost::range_value<
+                typename boost::range_value<const PatternRanges>::type>::type>
+                        ( boost::begin ( patterns ), boost::end ( patterns ));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_AHO_CORASICK_SEARCH_HPP
@@ -0,0 +1,244 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_BATCH_SEARCH_HPP
+#define BOOST_ALGORITHM_BATCH_SEARCH_HPP
+
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits
+#include <vector>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/empty.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching for one pattern in each of a large number of short records (the
+    values of a column of a table, lines of a log, and so on).
+
+    A batch_searcher builds its searcher once, and takes all the records at once.
+    For each record, it reports whether the pattern is in it (a bitmap), or where
+    the first match in it is (a position in the record, or npos).
+
+    The records can be given in two ways:
+        * An "arena": the records are stored one after another, and record i is
+          [ arena + offsets [i], arena + offsets [i+1] ), so there is one more offset
+          than there are records. The arena is searched as a single corpus; a match
+          that runs from one record into the next is discarded, and the search
+          restarts at the start of the next record. The searcher is only called
+          again after a match, so the records that don't match cost nothing
+          beyond the search itself.
+        * A range of ranges (such as a std::vector<std::string>). Each record is
+          searched on its own; records that are shorter than the pattern are
+          skipped without calling the searcher, and the next record is prefetched
+          while the current one is searched.
+
+    Requirements:
+        * The requirements of the searcher (by default, boyer_moore_horspool)
+        * Random access iterators for the arena and the offsets
+        * The offsets must not decrease
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    inline void batch_prefetch ( const void *p ) {
+#if defined(__GNUC__)
+        __builtin_prefetch ( p );
+#else
+        (void) p;
+#endif
+        }
+
+    template <typename OutputIterator>
+    struct batch_position_sink {
+        explicit batch_position_sink ( OutputIterator out ) : out_ ( out ) {}
+        void operator () ( std::size_t pos ) { *out_++ = pos; }
+        OutputIterator out_;
+        };
+
+    struct batch_bitmap_sink {
+        explicit batch_bitmap_sink ( std::vector<bool> &bits ) : bits_ ( bits ), matches_ ( 0 ) { bits_.clear (); }
+        void operator () ( std::size_t pos ) {
+            const bool found = pos != std::size_t ( -1 );
+            bits_.push_back ( found );
+            if ( found ) ++matches_;
+            }
+        std::vector<bool> &bits_;
+        std::size_t matches_;
+        };
+}
+/// \endcond
+
+    template <typename patIter, typename Searcher = boyer_moore_horspool<patIter> >
+    class batch_searcher {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+    public:
+        /// The position that is reported for records that don't contain the pattern
+        static const std::size_t npos = std::size_t ( -1 );
+
+        batch_searcher ( patIter first, patIter last )
+                : k_pattern_length ( std::distance ( first, last )), searcher_ ( first, last ) {}
+
+        ~batch_searcher () {}
+
+        /// \fn find_first ( corpusIter arena, OffsetIter offsets_first, OffsetIter offsets_last, OutputIterator out )
+        /// \brief For each record in the arena, writes the position of the first match in it, or npos
+        ///
+        /// \param arena            The start of the storage of the records (Random Access Iterator)
+        /// \param offsets_first    The start of the offsets of the records; one more than the number of records
+        /// \param offsets_last     One past the end of the offsets
+        /// \param out              An output iterator which receives a std::size_t for each record
+        ///
+        template <typename corpusIter, typename OffsetIter, typename OutputIterator>
+        OutputIterator find_first ( corpusIter arena, OffsetIter offsets_first, OffsetIter offsets_last,
+                                        OutputIterator out ) const {
+            detail::batch_position_sink<OutputIterator> sink ( out );
+            this->scan_arena ( arena, offsets_first, offsets_last, sink );
+            return sink.out_;
+            }
+
+        /// \fn match ( corpusIter arena, OffsetIter offsets_first, OffsetIter offsets_last, std::vector<bool> &bits )
+        /// \brief For each record in the arena, sets a bit if the pattern is in it
+        ///
+        /// \param arena            The start of the storage of the records (Random Access Iterator)
+        /// \param offsets_first    The start of the offsets of the records; one more than the number of records
+        /// \param offsets_last     One past the end of the offsets
+        /// \param bits             Receives one bit for each record
+        ///
+        /// Returns the number of records that contain the pattern.
+        template <typename corpusIter, typename OffsetIter>
+        std::size_t match ( corpusIter arena, OffsetIter offsets_first, OffsetIter offsets_last,
+                                        std::vector<bool> &bits ) const {
+            detail::batch_bitmap_sink sink ( bits );
+            this->scan_arena ( arena, offsets_first, offsets_last, sink );
+            return sink.matches_;
+            }
+
+        /// \fn find_first ( const RecordRange &records, OutputIterator out )
+        /// \brief For each record, writes the position of the first match in it, or npos
+        ///
+        /// \param records  A range of records, each of which is a range (Random Access)
+        /// \param out      An output iterator which receives a std::size_t for each record
+        ///
+        template <typename RecordRange, typename OutputIterator>
+        OutputIterator find_first ( const RecordRange &records, OutputIterator out ) const {
+            detail::batch_position_sink<OutputIterator> sink ( out );
+            this->scan_records ( boost::begin ( records ), boost::end ( records ), sink );
+            return sink.out_;
+            }
+
+        /// \fn match ( const RecordRange &records, std::vector<bool> &bits )
+        /// \brief For each record, sets a bit if the pattern is in it
+        ///
+        /// \param records  A range of records, each of which is a range (Random Access)
+        /// \param bits     Receives one bit for each record
+        ///
+        /// Returns the number of records that contain the pattern.
+        template <typename RecordRange>
+        std::size_t match ( const RecordRange &records, std::vector<bool> &bits ) const {
+            detail::batch_bitmap_sink sink ( bits );
+            this->scan_records ( boost::begin ( records ), boost::end ( records ), sink );
+            return sink.matches_;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const difference_type k_pattern_length;
+        Searcher searcher_;
+
+        template <typename corpusIter, typename OffsetIter, typename Sink>
+        void scan_arena ( corpusIter arena, OffsetIter offsets_first, OffsetIter offsets_last, Sink &sink ) const {
+            if ( offsets_first == offsets_last )
+                return;
+            const std::size_t k_records = std::distance ( offsets_first, offsets_last ) - 1;
+            const std::size_t m = k_pattern_length;
+
+        //  The empty pattern matches at the start of every record (that isn't empty)
+            if ( m == 0 ) {
+                for ( std::size_t r = 0; r < k_records; ++r )
+                    sink ( offsets_first [ r + 1 ] > offsets_first [ r ] ? 0 : npos );
+                return;
+                }
+
+            const corpusIter arena_last = arena + offsets_first [ k_records ];
+            std::size_t r = 0;
+            std::size_t pos = offsets_first [ 0 ];
+            while ( r < k_records ) {
+                const corpusIter found_iter = searcher_ ( arena + pos, arena_last );
+                if ( found_iter == arena_last )
+                    break;
+                const std::size_t found = std::distance ( arena, found_iter );
+
+            //  Every record before the one the match starts in has no match
+                while ( static_cast<std::size_t> ( offsets_first [ r + 1 ] ) <= found ) {
+                    sink ( npos );
+                    ++r;
+                    }
+                const std::size_t record_end = offsets_first [ r + 1 ];
+                sink ( found + m <= record_end ? found - offsets_first [ r ] : npos );
+                pos = record_end;
+                ++r;
+                }
+
+            for ( ; r < k_records; ++r )
+                sink ( npos );
+            }
+
+        template <typename RecordIter, typename Sink>
+        void scan_records ( RecordIter first, RecordIter last, Sink &sink ) const {
+            typedef typename std::iterator_traits<RecordIter>::value_type record_type;
+            typedef typename boost::range_iterator<const record_type>::type corpusIter;
+
+            for ( RecordIter iter = first; iter != last; ) {
+                const record_type &record = *iter;
+                if ( ++iter != last && !boost::empty ( *iter ))
+                    detail::batch_prefetch ( &*boost::begin ( *iter ));
+
+                const corpusIter rec_first = boost::begin ( record );
+                const corpusIter rec_last  = boost::end ( record );
+                if ( rec_first == rec_last || std::distance ( rec_first, rec_last ) < k_pattern_length ) {
+                    sink ( npos );
+                    continue;
+                    }
+                const corpusIter found = searcher_ ( rec_first, rec_last );
+                sink ( found == rec_last ? npos : std::size_t ( std::distance ( rec_first, found )));
+                }
+            }
+/// \endcond
+        };
+
+    template <typename patIter, typename Searcher>
+    const std::size_t batch_searcher<patIter, Searcher>::npos;
+
+
+/// \fn batch_match ( const RecordRange &records, patIter pat_first, patIter pat_last, std::vector<bool> &bits )
+/// \brief For each record, sets a bit if the pattern is in it.
+///
+/// \param records      A range of records, each of which is a range (Random Access)
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param bits         Receives one bit for each record
+///
+/// Returns the number of records that contain the pattern.
+    template <typename RecordRange, typename patIter>
+    std::size_t batch_match ( const RecordRange &records, patIter pat_first, patIter pat_last,
+                                std::vector<bool> &bits ) {
+        batch_searcher<patIter> bs ( pat_first, pat_last );
+        return bs.match ( records, bits );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_BATCH_SEARCH_HPP
@@ -10,7 +10,10 @@
 #ifndef BOOST_ALGORITHM_BOYER_MOORE_SEARCH_HPP
 #define BOOST_ALGORITHM_BOYER_MOORE_SEARCH_HPP
 
-#include <iterator>     // for std::iterator_traits
+#include <algorithm>    // for std::fill
+#include <iterator>     // for std::iterator_traits, std::reverse_iterator
+#include <memory>       // for std::allocator
+#include <vector>
 
 #include <boost/assert.hpp>
 #include <boost/static_assert.hpp>
@@ -23,6 +26,7 @@
 
 #include <boost/algorithm/searching/detail/bm_traits.hpp>
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/searching/search_stats.hpp>
 
 namespace boost { namespace algorithm {
 
@@ -50,23 +54,58 @@ Requirements:
         * Additional requirements may be imposed but the skip table, such as:
         ** Numeric type (array-based skip table)
         ** Hashable type (map-based skip table)
+
+If the traits supply a 'fold_type' (see bm_traits.hpp), both tables are built
+from the folded pattern, and elements are folded before they are compared.
+To ignore (ASCII) case, for example:
+    boyer_moore<const char *, case_insensitive_traits<const char *> >
+
+The "good character" table is allocated with 'Alloc', which must allocate
+the difference_type of the pattern iterator. A searcher can also be made from
+tables that have already been built (the ones in a blob of searcher tables, for
+example; see searcher_tables.hpp); 'SuffixTable' is then the type of a view of
+the "good character" table, which has an operator [].
+
+'Stats' is an instrumentation policy; see search_stats.hpp.
 */
 
-    template <typename patIter, typename traits = detail::BM_traits<patIter> >
-    class boyer_moore {
+    template <typename patIter, typename traits = detail::BM_traits<patIter>,
+              typename Stats = no_search_stats,
+              typename Alloc = std::allocator<typename std::iterator_traits<patIter>::difference_type>,
+              typename SuffixTable = std::vector<typename std::iterator_traits<patIter>::difference_type, Alloc> >
+    class boyer_moore : private detail::search_stats_holder<Stats> {
         typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename detail::traits_fold<traits>::type fold_type;
     public:
-        boyer_moore ( patIter first, patIter last ) 
+        typedef Alloc allocator_type;
+
+        boyer_moore ( patIter first, patIter last, const Alloc &alloc = Alloc ())
                 : pat_first ( first ), pat_last ( last ),
                   k_pattern_length ( std::distance ( pat_first, pat_last )),
                   skip_ ( k_pattern_length, -1 ),
-                  suffix_ ( k_pattern_length + 1 )
+                  suffix_ ( k_pattern_length + 1, difference_type (), alloc )
             {
             this->build_skip_table   ( first, last );
             this->build_suffix_table ( first, last );
             }
+
+        /// \fn boyer_moore ( patIter first, patIter last, const typename traits::skip_table_t &skip, const SuffixTable &suffix )
+        /// \brief Makes a searcher for the pattern from tables that have already been built
+        boyer_moore ( patIter first, patIter last,
+                        const typename traits::skip_table_t &skip, const SuffixTable &suffix )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  skip_ ( skip ), suffix_ ( suffix ) {}
             
         ~boyer_moore () {}
+
+        /// \fn stats ()
+        /// \brief The counters kept by the 'Stats' policy
+        const Stats &stats () const { return this->counters (); }
+
+        /// \fn reset_stats ()
+        /// \brief Sets the counters kept by the 'Stats' policy back to zero
+        void reset_stats () { this->counters () = Stats (); }
         
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -97,12 +136,94 @@ Requirements:
             return (*this) (boost::begin(r), boost::end(r));
             }
 
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                                    typename std::iterator_traits<patIter>::value_type,
+                                    typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) {            // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return out;
+
+            corpusIter curPos = corpus_first;
+            while (( curPos = this->do_search ( curPos, corpus_last )) != corpus_last ) {
+                *out++ = curPos;
+                if ( !overlapping ) {
+                    this->counters ().on_shift ( k_pattern_length );
+                    curPos += k_pattern_length;
+                    continue;
+                    }
+
+                while ( this->next_overlap ( curPos, corpus_last ))
+                    *out++ = curPos;
+                }
+            return out;
+            }
+
+        /// \class cursor
+        /// \brief Finds the matches in a corpus one at a time (see matches () in match_generator.hpp)
+        ///
+        /// Like find_all, Galil's rule is applied after each match, so the search
+        /// stays linear however many (overlapping) matches are asked for.
+        template <typename corpusIter>
+        class cursor {
+        public:
+            cursor ( const boyer_moore &searcher, corpusIter corpus_first, corpusIter corpus_last )
+                    : searcher_ ( searcher ), curPos_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                      matched_ ( false ) {
+                BOOST_STATIC_ASSERT (( boost::is_same<
+                                        typename std::iterator_traits<patIter>::value_type,
+                                        typename std::iterator_traits<corpusIter>::value_type>::value ));
+            //  If the pattern is larger than the corpus, we can't find it!
+                if ( std::distance ( corpus_first, corpus_last ) < searcher.k_pattern_length )
+                    curPos_ = corpus_last;
+                }
+
+            /// \fn next ()
+            /// \brief Returns the next match, or corpus_last when there are no more
+            corpusIter next () {
+                if ( searcher_.k_pattern_length == 0 )      // empty pattern matches everywhere
+                    return curPos_ == corpus_last_ ? corpus_last_ : curPos_++;
+                if ( matched_ && searcher_.next_overlap ( curPos_, corpus_last_ ))
+                    return curPos_;
+                if ( curPos_ != corpus_last_ )
+                    curPos_ = searcher_.do_search ( curPos_, corpus_last_ );
+                matched_ = curPos_ != corpus_last_;
+                return curPos_;
+                }
+
+        private:
+            const boyer_moore &searcher_;
+            corpusIter curPos_;
+            const corpusIter corpus_last_;
+            bool matched_;
+            };
+
     private:
 /// \cond DOXYGEN_HIDE
+        friend class searcher_tables_writer;
+
         patIter pat_first, pat_last;
         const difference_type k_pattern_length;
         typename traits::skip_table_t skip_;
-        std::vector <difference_type> suffix_;
+        SuffixTable suffix_;
 
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -116,35 +237,72 @@ Requirements:
         /*  ---- Do the matching ---- */
             corpusIter curPos = corpus_first;
             const corpusIter lastPos = corpus_last - k_pattern_length;
-            difference_type j, k, m;
+            difference_type j;
 
             while ( curPos <= lastPos ) {
         /*  while ( std::distance ( curPos, corpus_last ) >= k_pattern_length ) { */
             //  Do we match right where we are?
                 j = k_pattern_length;
-                while ( pat_first [j-1] == curPos [j-1] ) {
+                while ( fold_type::apply ( pat_first [j-1] ) == fold_type::apply ( curPos [j-1] )) {
                     j--;
                 //  We matched - we're done!
-                    if ( j == 0 )
+                    if ( j == 0 ) {
+                        this->counters ().on_compare ( k_pattern_length );
                         return curPos;
+                        }
                     }
+                this->counters ().on_compare ( k_pattern_length - j + 1 );
                 
             //  Since we didn't match, figure out how far to skip forward
-                k = skip_ [ curPos [ j - 1 ]];
-                m = j - k - 1;
-                if ( k < j && m > suffix_ [ j ] )
-                    curPos += m;
-                else
-                    curPos += suffix_ [ j ];
+                curPos += this->mismatch_shift ( j, curPos [ j - 1 ] );
                 }
         
             return corpus_last;     // We didn't find anything
             }
 
+    //  Galil's rule: after a match at 'curPos', shift by the period of the pattern. The
+    //  first (pattern_length - period) elements of the new window are already known to
+    //  match, so only the rest need to be compared. This keeps the search linear, even
+    //  when there are many (overlapping) matches.
+    //  Returns true if the pattern matches at the new 'curPos'; otherwise 'curPos' is
+    //  moved past the mismatch (or to corpus_last, if the corpus is used up).
+        template <typename corpusIter>
+        bool next_overlap ( corpusIter &curPos, corpusIter corpus_last ) const {
+            const difference_type k_period = suffix_ [ 0 ];
+            const difference_type k_known  = k_pattern_length - k_period;
+            this->counters ().on_shift ( k_period );
+            curPos += k_period;
+            if ( std::distance ( curPos, corpus_last ) < k_pattern_length ) {
+                curPos = corpus_last;
+                return false;
+                }
+            difference_type j = k_pattern_length;
+            while ( j > k_known && fold_type::apply ( pat_first [j-1] ) == fold_type::apply ( curPos [j-1] ))
+                j--;
+            this->counters ().on_compare ( k_pattern_length - j + ( j > k_known ? 1 : 0 ));
+            if ( j == k_known )
+                return true;
+
+        //  We didn't match; skip forward from the mismatch, and go back to searching
+            curPos += this->mismatch_shift ( j, curPos [ j - 1 ] );
+            return false;
+            }
+
+    //  The shift after the pattern matched from j to the end, and 'c' didn't match pattern [j-1]
+        template <typename T>
+        difference_type mismatch_shift ( difference_type j, const T &c ) const {
+            this->counters ().on_lookup ( 2 );
+            const difference_type k = skip_ [ fold_type::apply ( c ) ];
+            const difference_type m = j - k - 1;
+            const difference_type shift = ( k < j && m > suffix_ [ j ] ) ? m : suffix_ [ j ];
+            this->counters ().on_shift ( shift );
+            return shift;
+            }
+
 
         void build_skip_table ( patIter first, patIter last ) {
             for ( std::size_t i = 0; first != last; ++first, ++i )
-                skip_.insert ( *first, i );
+                skip_.insert ( fold_type::apply ( *first ), i );
             }
         
 
@@ -152,38 +310,36 @@ Requirements:
         void compute_bm_prefix ( Iter pat_first, Iter pat_last, Container &prefix ) {
             const std::size_t count = std::distance ( pat_first, pat_last );
             BOOST_ASSERT ( count > 0 );
-            BOOST_ASSERT ( prefix.size () == count );
+            BOOST_ASSERT ( prefix.size () >= count );
                             
             prefix[0] = 0;
             std::size_t k = 0;
             for ( std::size_t i = 1; i < count; ++i ) {
                 BOOST_ASSERT ( k < count );
-                while ( k > 0 && ( pat_first[k] != pat_first[i] )) {
+                while ( k > 0 && !( fold_type::apply ( pat_first[k] ) == fold_type::apply ( pat_first[i] ))) {
                     BOOST_ASSERT ( k < count );
                     k = prefix [ k - 1 ];
                     }
                     
-                if ( pat_first[k] == pat_first[i] )
+                if ( fold_type::apply ( pat_first[k] ) == fold_type::apply ( pat_first[i] ))
                     k++;
                 prefix [ i ] = k;
                 }
             }
 
+    //  Only the last element of the prefix table of the pattern is needed, so it is
+    //  built in suffix_; the prefix table of the reversed pattern is the only scratch space.
         void build_suffix_table ( patIter pat_first, patIter pat_last ) {
             const std::size_t count = (std::size_t) std::distance ( pat_first, pat_last );
             
             if ( count > 0 ) {  // empty pattern
-                std::vector<typename std::iterator_traits<patIter>::value_type> reversed(count);
-                (void) std::reverse_copy ( pat_first, pat_last, reversed.begin ());
-                
-                std::vector<difference_type> prefix (count);
-                compute_bm_prefix ( pat_first, pat_last, prefix );
-        
-                std::vector<difference_type> prefix_reversed (count);
-                compute_bm_prefix ( reversed.begin (), reversed.end (), prefix_reversed );
-                
-                for ( std::size_t i = 0; i <= count; i++ )
-                    suffix_[i] = count - prefix [count-1];
+                typedef std::reverse_iterator<patIter> reversed_iter;
+                std::vector<difference_type, Alloc> prefix_reversed ( count, difference_type (), suffix_.get_allocator ());
+                compute_bm_prefix ( reversed_iter ( pat_last ), reversed_iter ( pat_first ), prefix_reversed );
+
+                compute_bm_prefix ( pat_first, pat_last, suffix_ );
+                const difference_type k_shift = count - suffix_ [ count - 1 ];
+                std::fill ( suffix_.begin (), suffix_.end (), k_shift );
          
                 for ( std::size_t i = 0; i < count; i++ ) {
                     const std::size_t     j = count - prefix_reversed[i];
@@ -248,6 +404,28 @@ Requirements:
     }
 
 
+/// \fn boyer_moore_find_all ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last, OutputIterator out, bool overlapping )
+/// \brief Searches the corpus for every occurrence of the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param out          An output iterator which receives an iterator to the start of each match
+/// \param overlapping  If false, matches that overlap an earlier match are not reported
+///
+    template <typename patIter, typename corpusIter, typename OutputIterator>
+    OutputIterator boyer_moore_find_all (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last,
+                  OutputIterator out, bool overlapping = true )
+    {
+        boyer_moore<patIter> bm ( pat_first, pat_last );
+        return bm.find_all ( corpus_first, corpus_last, out, overlapping );
+    }
+
+
     //  Creator functions -- take a pattern range, return an object
     template <typename Range>
     boost::algorithm::boyer_moore<typename boost::range_iterator<const Range>::type>
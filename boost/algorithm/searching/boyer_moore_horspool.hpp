@@ -18,6 +18,7 @@
 
 #include <boost/algorithm/searching/detail/bm_traits.hpp>
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/searching/search_stats.hpp>
 
 // #define  BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_DEBUG_HPP
 
@@ -34,13 +35,26 @@ namespace boost { namespace algorithm {
         ** Numeric type (array-based skip table)
         ** Hashable type (map-based skip table)
 
+    The traits may supply a 'fold_type' (see bm_traits.hpp); the skip table is
+    built on the folded pattern, and elements are folded before they are compared.
+    For example, to search bytes without regard to (ASCII) case:
+        boyer_moore_horspool<const char *, case_insensitive_traits<const char *> >
+    and with any other fold, folding_traits<patIter, Fold>.
+
+    A searcher can also be made from a skip table that has already been built
+    (the one in a blob of searcher tables, for example; see searcher_tables.hpp).
+
+    'Stats' is an instrumentation policy; see search_stats.hpp.
+
 http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
 
 */
 
-    template <typename patIter, typename traits = detail::BM_traits<patIter> >
-    class boyer_moore_horspool {
+    template <typename patIter, typename traits = detail::BM_traits<patIter>,
+              typename Stats = no_search_stats>
+    class boyer_moore_horspool : private detail::search_stats_holder<Stats> {
         typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename detail::traits_fold<traits>::type fold_type;
     public:
         boyer_moore_horspool ( patIter first, patIter last ) 
                 : pat_first ( first ), pat_last ( last ),
@@ -51,13 +65,28 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
             std::size_t i = 0;
             if ( first != last )    // empty pattern?
                 for ( patIter iter = first; iter != last-1; ++iter, ++i )
-                    skip_.insert ( *iter, k_pattern_length - 1 - i );
+                    skip_.insert ( fold_type::apply ( *iter ), k_pattern_length - 1 - i );
 #ifdef BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_DEBUG_HPP
             skip_.PrintSkipTable ();
 #endif
             }
+
+        /// \fn boyer_moore_horspool ( patIter first, patIter last, const typename traits::skip_table_t &skip )
+        /// \brief Makes a searcher for the pattern from a skip table that has already been built
+        boyer_moore_horspool ( patIter first, patIter last, const typename traits::skip_table_t &skip )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  skip_ ( skip ) {}
             
         ~boyer_moore_horspool () {}
+
+        /// \fn stats ()
+        /// \brief The counters kept by the 'Stats' policy
+        const Stats &stats () const { return this->counters (); }
+
+        /// \fn reset_stats ()
+        /// \brief Sets the counters kept by the 'Stats' policy back to zero
+        void reset_stats () { this->counters () = Stats (); }
         
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -84,8 +113,52 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
             return this->do_search ( corpus_first, corpus_last );
             }
             
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type, 
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) {            // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return out;
+
+        //  After a match, either take the usual skip for the last element, or jump past the match
+            corpusIter curPos = corpus_first;
+            while (( curPos = this->do_search ( curPos, corpus_last )) != corpus_last ) {
+                *out++ = curPos;
+                difference_type shift = k_pattern_length;
+                if ( overlapping ) {
+                    this->counters ().on_lookup ( 1 );
+                    shift = skip_ [ fold_type::apply ( curPos [ k_pattern_length - 1 ] ) ];
+                    }
+                this->counters ().on_shift ( shift );
+                curPos += shift;
+                }
+            return out;
+            }
+
     private:
 /// \cond DOXYGEN_HIDE
+        template <typename, typename> friend class boyer_moore_horspool_stream;
+        friend class searcher_tables_writer;
+
         patIter pat_first, pat_last;
         const difference_type k_pattern_length;
         typename traits::skip_table_t skip_;
@@ -104,14 +177,20 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
             while ( curPos <= lastPos ) {
             //  Do we match right where we are?
                 std::size_t j = k_pattern_length - 1;
-                while ( pat_first [j] == curPos [j] ) {
+                while ( fold_type::apply ( pat_first [j] ) == fold_type::apply ( curPos [j] )) {
                 //  We matched - we're done!
-                    if ( j == 0 )
+                    if ( j == 0 ) {
+                        this->counters ().on_compare ( k_pattern_length );
                         return curPos;
+                        }
                     j--;
                     }
-        
-                curPos += skip_ [ curPos [ k_pattern_length - 1 ]];
+                this->counters ().on_compare ( k_pattern_length - j );
+
+                this->counters ().on_lookup ( 1 );
+                const difference_type shift = skip_ [ fold_type::apply ( curPos [ k_pattern_length - 1 ] ) ];
+                this->counters ().on_shift ( shift );
+                curPos += shift;
                 }
             
             return corpus_last;
@@ -136,6 +215,26 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
         return bmh ( corpus_first, corpus_last );
         }
 
+/// \fn boyer_moore_horspool_find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+///       patIter pat_first, patIter pat_last, OutputIterator out, bool overlapping )
+/// \brief Searches the corpus for every occurrence of the pattern.
+/// 
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param out          An output iterator which receives an iterator to the start of each match
+/// \param overlapping  If false, matches that overlap an earlier match are not reported
+///
+    template <typename patIter, typename corpusIter, typename OutputIterator>
+    OutputIterator boyer_moore_horspool_find_all ( 
+            corpusIter corpus_first, corpusIter corpus_last, 
+            patIter pat_first, patIter pat_last,
+            OutputIterator out, bool overlapping = true ) {
+        boyer_moore_horspool<patIter> bmh ( pat_first, pat_last );
+        return bmh.find_all ( corpus_first, corpus_last, out, overlapping );
+        }
+
 }}
 
 #endif  //  BOOST_ALGORITHM_BOYER_MOORE_HORSPOOOL_SEARCH_HPP
@@ -0,0 +1,276 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_QGRAM_SEARCH_HPP
+#define BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_QGRAM_SEARCH_HPP
+
+#include <algorithm>    // for std::search, std::fill
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits
+#include <limits>       // for std::numeric_limits
+
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A version of boyer-moore-horspool that shifts on the last q elements of the
+    window (a q-gram), rather than on the last one, as Wu and Manber do.
+
+    When the alphabet is small (DNA has four letters), every element appears near
+    the end of the pattern, so the skip table of boyer_moore_horspool gives shifts
+    of one to three, and the search is little faster than a naive one. A q-gram
+    near the end of a window is much less likely to appear in the pattern, and
+    the shift is usually m - q + 1, where m is the length of the pattern.
+
+    The q-grams are hashed into a flat table of 2^table_bits shifts: each element
+    is shifted into the hash by table_bits / q bits. For q = 2, 3 and 4 the low
+    three bits of each element land in separate bits of the hash, so the q-grams
+    of 'A', 'C', 'G' and 'T' (in either case) never collide. Other alphabets may
+    collide; that only makes the shifts shorter. The shifts are stored in 16 bits
+    (so the table fits in the L1 cache); longer shifts are clamped, which is
+    also safe.
+
+    q (2, 3 or 4; by default 3) and the fold are chosen with qgram_traits:
+        boyer_moore_horspool_qgram<const char *, qgram_traits<const char *, 4> >
+        boyer_moore_horspool_qgram<const char *, qgram_traits<const char *, 4, ascii_case_fold> >
+    Longer patterns get more out of a larger q. A pattern that is shorter than q
+    is searched for with std::search.
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type, which must be integral.
+
+http://webglimpse.net/pubs/TR94-17.pdf
+*/
+
+    template<typename Iterator, std::size_t Q = 3, typename Fold = no_fold>
+    struct qgram_traits {
+        BOOST_STATIC_ASSERT (( Q >= 2 && Q <= 4 ));
+        BOOST_STATIC_CONSTANT ( std::size_t, q = Q );
+        BOOST_STATIC_CONSTANT ( std::size_t, table_bits = 12 );
+        BOOST_STATIC_CONSTANT ( std::size_t, hash_shift = table_bits / Q );
+        typedef boost::uint16_t value_type;
+        typedef typename std::iterator_traits<Iterator>::value_type key_type;
+        typedef Fold fold_type;
+        };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    template <typename Fold>
+    struct fold_equal {
+        template <typename T>
+        bool operator () ( T a, T b ) const { return Fold::apply ( a ) == Fold::apply ( b ); }
+        };
+}
+/// \endcond
+
+    template <typename patIter, typename traits = qgram_traits<patIter> >
+    class boyer_moore_horspool_qgram {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename std::iterator_traits<patIter>::value_type element_type;
+        typedef typename boost::make_unsigned<element_type>::type unsigned_element_type;
+        typedef typename detail::traits_fold<traits>::type fold_type;
+        typedef typename traits::value_type shift_type;
+        BOOST_STATIC_ASSERT (( boost::is_integral<element_type>::value ));
+        BOOST_STATIC_CONSTANT ( std::size_t, k_q = traits::q );
+        BOOST_STATIC_CONSTANT ( std::size_t, k_table_size = std::size_t ( 1 ) << traits::table_bits );
+    public:
+        boyer_moore_horspool_qgram ( patIter first, patIter last )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  k_hit_shift ( 1 ) {
+
+        //  Build the shift table; the later a q-gram is in the pattern, the smaller its
+        //  shift, so later ones overwrite earlier ones that hash the same.
+            const difference_type k_q_diff = static_cast<difference_type> ( k_q );
+            const difference_type k_grams = k_pattern_length - k_q_diff + 1;
+            std::fill ( skip_.begin (), skip_.end (), clamp ( k_grams > 0 ? k_grams : 1 ));
+            if ( k_grams > 0 ) {
+                for ( difference_type i = 0; i < k_grams; ++i )
+                    skip_ [ hash ( pat_first + i ) ] = clamp ( k_grams - 1 - i );
+
+            //  After looking at a window, shift to the next place that the last q-gram
+            //  of the window (which hashes the same as the pattern's last q-gram) appears
+                const std::size_t k_last = hash ( pat_first + k_grams - 1 );
+                k_hit_shift = k_grams;
+                for ( difference_type i = 0; i < k_grams - 1; ++i )
+                    if ( hash ( pat_first + i ) == k_last )
+                        k_hit_shift = k_grams - 1 - i;
+                }
+            }
+
+        ~boyer_moore_horspool_qgram () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+            return this->do_search ( corpus_first, corpus_last );
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) {            // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return out;
+
+            corpusIter curPos = corpus_first;
+            while ( corpus_last - curPos >= k_pattern_length &&
+                        ( curPos = this->do_search ( curPos, corpus_last )) != corpus_last ) {
+                *out++ = curPos;
+                curPos += overlapping ? k_hit_shift : k_pattern_length;
+                }
+            return out;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        difference_type k_hit_shift;
+        boost::array<shift_type, k_table_size> skip_;
+
+        static shift_type clamp ( difference_type shift ) {
+            const difference_type k_max = (std::numeric_limits<shift_type>::max) ();
+            return static_cast<shift_type> ( shift < k_max ? shift : k_max );
+            }
+
+        template <typename Iter>
+        static std::size_t hash ( Iter p ) {
+            std::size_t h = 0;
+            for ( std::size_t i = 0; i < k_q; ++i )
+                h = ( h << traits::hash_shift ) ^
+                        static_cast<unsigned_element_type> ( fold_type::apply ( p [ i ] ));
+            return h & ( k_table_size - 1 );
+            }
+
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            if ( k_pattern_length < static_cast<difference_type> ( k_q ))
+                return std::search ( corpus_first, corpus_last, pat_first, pat_last,
+                                        detail::fold_equal<fold_type> ());
+
+            corpusIter curPos = corpus_first;
+            const corpusIter lastPos = corpus_last - k_pattern_length;
+            const difference_type k_tail = k_pattern_length - k_q;
+            while ( curPos <= lastPos ) {
+                const shift_type shift = skip_ [ hash ( curPos + k_tail ) ];
+                if ( shift != 0 ) {
+                    curPos += shift;
+                    continue;
+                    }
+
+            //  The last q-gram (probably) matches; check the rest of the window
+                difference_type j = 0;
+                while ( fold_type::apply ( pat_first [j] ) == fold_type::apply ( curPos [j] ))
+                    if ( ++j == k_pattern_length )
+                        return curPos;
+                curPos += k_hit_shift;
+                }
+
+            return corpus_last;
+            }
+/// \endcond
+        };
+
+/// \fn boyer_moore_horspool_qgram_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter boyer_moore_horspool_qgram_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        boyer_moore_horspool_qgram<patIter> bmhq ( pat_first, pat_last );
+        return bmhq ( corpus_first, corpus_last );
+        }
+
+/// \fn boyer_moore_horspool_qgram_find_all ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last, OutputIterator out, bool overlapping )
+/// \brief Searches the corpus for every occurrence of the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param out          An output iterator which receives an iterator to the start of each match
+/// \param overlapping  If false, matches that overlap an earlier match are not reported
+///
+    template <typename patIter, typename corpusIter, typename OutputIterator>
+    OutputIterator boyer_moore_horspool_qgram_find_all (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last,
+            OutputIterator out, bool overlapping = true ) {
+        boyer_moore_horspool_qgram<patIter> bmhq ( pat_first, pat_last );
+        return bmhq.find_all ( corpus_first, corpus_last, out, overlapping );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_QGRAM_SEARCH_HPP
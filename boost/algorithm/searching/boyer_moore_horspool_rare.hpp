@@ -0,0 +1,294 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_RARE_SEARCH_HPP
+#define BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_RARE_SEARCH_HPP
+
+#include <algorithm>    // for std::equal
+#include <cstring>      // for std::memchr
+#include <iterator>     // for std::iterator_traits
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+#include <boost/algorithm/searching/detail/simd_search.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A searcher for byte sequences that looks for the rarest bytes of the pattern
+    first, with the same interface as boyer_moore_horspool.
+
+    On text, most of the bytes of a pattern are common ones, and a search that
+    examines the corpus at the position of a common byte spends its time on
+    candidates that fail. Instead, this searcher uses a table of how common each
+    byte value is to pick the two rarest bytes of the pattern (at different
+    positions, and with different values where possible). The corpus is scanned
+    for places where both of them match, 16 (SSE2) or 32 (AVX2) positions at a
+    time, and only those candidates are compared with the whole pattern.
+
+    The built-in table is for English text, source code and log files; any other
+    table of 256 entries (larger means more common) can be passed to the
+    constructor. compute_byte_frequencies builds one from a sample of the data
+    to be searched.
+
+    A pattern of a single byte is searched for with memchr. Without SSE2, the
+    rarest byte of the pattern is searched for with memchr, and each place it
+    is found is a candidate. Anything that cannot be searched a byte at a time
+    is handed to a boyer_moore_horspool object, built from the same pattern:
+        * element types that are not single bytes
+        * traits with a fold (such as case-insensitive searching)
+        * corpus iterators that are not pointers (the storage must be contiguous)
+        * the last few positions of the corpus, which are too short for a full vector
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type.
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  How common each byte is, in English text, source code and logs (0 .. 255).
+//  Spaces, lower-case letters and digits are the most common; control characters
+//  are the rarest. Bytes above 0x7F are taken to be UTF-8, and uncommon.
+    inline const unsigned char *default_byte_frequencies () {
+        static const unsigned char table [ 256 ] = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0, 107, 225,   0,   0,  61,   0,   0,   // 00
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   // 10
+            255,  89, 141,  83,  77,  81,  85, 137, 135, 133,  93,  91, 211, 197, 209, 179,   // 20
+            203, 201, 199, 193, 191, 189, 187, 185, 183, 181, 195,  95,  97, 175,  99,  87,   // 30
+             79, 169, 145, 163, 151, 167, 143, 131, 147, 165, 109, 113, 149, 155, 159, 157,   // 40
+            153, 105, 161, 171, 173, 127, 115, 129, 103, 111, 101, 119,  63, 117,  67, 177,   // 50
+             65, 249, 213, 231, 233, 253, 223, 219, 237, 245, 125, 205, 235, 227, 243, 247,   // 60
+            221, 123, 239, 241, 251, 229, 207, 217, 139, 215, 121,  75,  71,  73,  69,   0,   // 70
+              8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   // 80
+              8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   // 90
+              8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   // A0
+              8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   // B0
+              8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   // C0
+              8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   // D0
+              8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   // E0
+              8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   // F0
+            };
+        return table;
+        }
+
+//  Can we search the corpus [first, last) a byte at a time (with memchr, or vector loads)?
+    template <typename value_type, typename corpusIter>
+    struct is_byte_searchable {
+        BOOST_STATIC_CONSTANT ( bool, value =
+            boost::is_integral<value_type>::value && sizeof(value_type) == 1 &&
+            boost::is_pointer<corpusIter>::value );
+        };
+}
+/// \endcond
+
+/// \fn compute_byte_frequencies ( Iter first, Iter last, unsigned char *table )
+/// \brief Builds a byte frequency table, for boyer_moore_horspool_rare, from a sample of the data
+///
+/// \param first    The start of the sample
+/// \param last     One past the end of the sample
+/// \param table    Receives 256 entries; the most common byte in the sample gets 255,
+///                 and bytes that do not appear get 0
+///
+    template <typename Iter>
+    void compute_byte_frequencies ( Iter first, Iter last, unsigned char *table ) {
+        std::vector<std::size_t> counts ( 256, 0 );
+        std::size_t most = 0;
+        for ( ; first != last; ++first ) {
+            const std::size_t c = ++counts [ static_cast<unsigned char> ( *first ) ];
+            if ( c > most ) most = c;
+            }
+        for ( std::size_t i = 0; i < 256; ++i )
+            table [ i ] = counts [ i ] == 0 ? 0 :
+                static_cast<unsigned char> ( 1 + ( 254.0 * counts [ i ] ) / most );
+        }
+
+    template <typename patIter, typename traits = detail::BM_traits<patIter> >
+    class boyer_moore_horspool_rare {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename detail::traits_fold<traits>::type fold_type;
+    public:
+        /// \fn boyer_moore_horspool_rare ( patIter first, patIter last, const unsigned char *frequencies )
+        /// \param first        The start of the pattern to search for (Random Access Iterator)
+        /// \param last         One past the end of the pattern
+        /// \param frequencies  How common each byte value is (256 entries; larger is more common)
+        ///
+        boyer_moore_horspool_rare ( patIter first, patIter last,
+                        const unsigned char *frequencies = detail::default_byte_frequencies ())
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  rare_ ( 0, k_pattern_length == 0 ? 0 : k_pattern_length - 1 ),
+                  bmh_ ( first, last ),
+#ifdef BOOST_ALGORITHM_SEARCH_SSE2
+                  use_avx2_ ( detail::cpu_has_avx2 ())
+#else
+                  use_avx2_ ( false )
+#endif
+        {
+            this->pick_rare ( frequencies, boost::integral_constant<bool,
+                        boost::is_integral<value_type>::value && sizeof(value_type) == 1> ());
+            }
+
+        ~boyer_moore_horspool_rare () {}
+
+        /// \fn rare_offsets ()
+        /// \brief The positions in the pattern of the two bytes that the corpus is scanned for;
+        ///        the rarest one first
+        std::pair<difference_type, difference_type> rare_offsets () const { return rare_; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            return this->do_search ( corpus_first, corpus_last,
+                boost::integral_constant<bool,
+                        detail::is_byte_searchable<value_type, corpusIter>::value &&
+                        boost::is_same<fold_type, no_fold>::value> ());
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        std::pair<difference_type, difference_type> rare_;
+        boyer_moore_horspool<patIter, traits> bmh_;
+        bool use_avx2_;
+
+    //  Not bytes; the offsets are never used
+        void pick_rare ( const unsigned char *, boost::false_type ) {}
+
+    //  The rarest byte; then the rarest one with a different value, if there is one
+    //  (a pair of equal bytes says little more than one of them does).
+    //  On ties, prefer the later position, as B-M-H does.
+        void pick_rare ( const unsigned char *frequencies, boost::true_type ) {
+            if ( k_pattern_length < 2 )
+                return;
+            difference_type r1 = k_pattern_length - 1;
+            for ( difference_type i = k_pattern_length - 1; i-- > 0; )
+                if ( frequencies [ pat_byte ( i ) ] < frequencies [ pat_byte ( r1 ) ] )
+                    r1 = i;
+
+            difference_type r2 = -1;
+            for ( difference_type i = k_pattern_length; i-- > 0; ) {
+                if ( i == r1 ) continue;
+                if ( r2 < 0 ) { r2 = i; continue; }
+                const bool i_differs  = pat_byte ( i )  != pat_byte ( r1 );
+                const bool r2_differs = pat_byte ( r2 ) != pat_byte ( r1 );
+                if ( i_differs != r2_differs ? i_differs
+                                             : frequencies [ pat_byte ( i ) ] < frequencies [ pat_byte ( r2 ) ] )
+                    r2 = i;
+                }
+            rare_ = std::make_pair ( r1, r2 );
+            }
+
+        unsigned char pat_byte ( difference_type i ) const {
+            return static_cast<unsigned char> ( pat_first [ i ] );
+            }
+
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) const {
+            return bmh_ ( corpus_first, corpus_last );
+            }
+
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) const {
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+            const unsigned char *corpus = reinterpret_cast<const unsigned char *> ( corpus_first );
+#ifdef BOOST_ALGORITHM_SEARCH_SSE2
+            if ( k_pattern_length > 1 ) {
+                std::size_t pos;
+                bool found;
+#ifdef BOOST_ALGORITHM_SEARCH_AVX2
+                if ( use_avx2_ )
+                    found = detail::avx2_search ( corpus, k_corpus_length, pat_first, k_pattern_length,
+                                                    rare_.first, rare_.second, pos );
+                else
+#endif
+                    found = detail::sse2_search ( corpus, k_corpus_length, pat_first, k_pattern_length,
+                                                    rare_.first, rare_.second, pos );
+
+                if ( found )
+                    return corpus_first + pos;
+            //  Search the tail that was too short for the vector loop
+                return bmh_ ( corpus_first + pos, corpus_last );
+                }
+#endif
+
+        //  Look for the rarest byte with memchr; each place it is found is a candidate
+            const unsigned char rare = pat_byte ( rare_.first );
+            const unsigned char *curPos = corpus + rare_.first;
+            const unsigned char *const last = corpus + k_corpus_length - ( k_pattern_length - 1 - rare_.first );
+            while ( curPos != last ) {
+                const void *res = std::memchr ( curPos, rare, last - curPos );
+                if ( res == NULL )
+                    break;
+                const unsigned char *candidate = static_cast<const unsigned char *> ( res ) - rare_.first;
+                if ( std::equal ( pat_first, pat_last, corpus_first + ( candidate - corpus )))
+                    return corpus_first + ( candidate - corpus );
+                curPos = static_cast<const unsigned char *> ( res ) + 1;
+                }
+            return corpus_last;
+            }
+/// \endcond
+        };
+
+/// \fn boyer_moore_horspool_rare_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter boyer_moore_horspool_rare_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        boyer_moore_horspool_rare<patIter> bmh ( pat_first, pat_last );
+        return bmh ( corpus_first, corpus_last );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_RARE_SEARCH_HPP
@@ -0,0 +1,158 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_SIMD_SEARCH_HPP
+#define BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_SIMD_SEARCH_HPP
+
+#include <cstring>      // for std::memchr
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+#include <boost/algorithm/searching/detail/simd_search.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A vectorized searcher for byte sequences, with the same interface
+    as boyer_moore_horspool.
+
+    For short patterns, the skips that Boyer-Moore-Horspool can make are
+    small, and most of the time is spent on the skip table lookups. Instead,
+    this searcher compares the first and last elements of the pattern against
+    16 (SSE2) or 32 (AVX2) consecutive positions in the corpus at once, and
+    only examines the positions where both of them match.
+
+    The AVX2 code is selected at runtime, if the processor supports it.
+    Anything that cannot be searched with vector instructions is handed
+    to a boyer_moore_horspool object, built from the same pattern:
+        * element types that are not single bytes
+        * traits with a fold (such as case-insensitive searching)
+        * corpus iterators that are not pointers (the storage must be contiguous)
+        * processors without SSE2, or when BOOST_ALGORITHM_NO_SIMD is defined
+        * the last few positions of the corpus, which are too short for a full vector
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type.
+
+    http://0x80.pl/articles/simd-strfind.html
+*/
+
+    template <typename patIter, typename traits = detail::BM_traits<patIter> >
+    class boyer_moore_horspool_simd {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename detail::traits_fold<traits>::type fold_type;
+    public:
+        boyer_moore_horspool_simd ( patIter first, patIter last )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  bmh_ ( first, last ),
+#ifdef BOOST_ALGORITHM_SEARCH_SSE2
+                  use_avx2_ ( detail::cpu_has_avx2 ())
+#else
+                  use_avx2_ ( false )
+#endif
+            {}
+
+        ~boyer_moore_horspool_simd () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            return this->do_search ( corpus_first, corpus_last,
+                boost::integral_constant<bool,
+                        detail::is_simd_searchable<value_type, corpusIter>::value &&
+                        boost::is_same<fold_type, no_fold>::value> ());
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        boyer_moore_horspool<patIter, traits> bmh_;
+        bool use_avx2_;
+
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) const {
+            return bmh_ ( corpus_first, corpus_last );
+            }
+
+#ifdef BOOST_ALGORITHM_SEARCH_SSE2
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) const {
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+            const unsigned char *corpus = reinterpret_cast<const unsigned char *> ( corpus_first );
+        //  A single element; the C library already has a fast search for that.
+            if ( k_pattern_length == 1 ) {
+                const void *res = std::memchr ( corpus, static_cast<unsigned char> ( *pat_first ), k_corpus_length );
+                return res == NULL ? corpus_last
+                    : corpus_first + ( static_cast<const unsigned char *> ( res ) - corpus );
+                }
+
+            std::size_t pos;
+            bool found;
+#ifdef BOOST_ALGORITHM_SEARCH_AVX2
+            if ( use_avx2_ )
+                found = detail::avx2_search ( corpus, k_corpus_length, pat_first, k_pattern_length, pos );
+            else
+#endif
+                found = detail::sse2_search ( corpus, k_corpus_length, pat_first, k_pattern_length, pos );
+
+            if ( found )
+                return corpus_first + pos;
+        //  Search the tail that was too short for the vector loop
+            return bmh_ ( corpus_first + pos, corpus_last );
+            }
+#endif
+/// \endcond
+        };
+
+/// \fn boyer_moore_horspool_simd_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter boyer_moore_horspool_simd_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        boyer_moore_horspool_simd<patIter> bmh ( pat_first, pat_last );
+        return bmh ( corpus_first, corpus_last );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_SIMD_SEARCH_HPP
@@ -0,0 +1,258 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_WILDCARD_SEARCH_HPP
+#define BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_WILDCARD_SEARCH_HPP
+
+#include <iterator>     // for std::iterator_traits
+#include <string>
+#include <vector>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/algorithm/hex.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching for a pattern with "don't care" positions, which match any element
+    (such as the byte signature "4D 5A ?? ?? 50 45").
+
+    The longest run of fixed (not wildcard) elements in the pattern is used as an
+    anchor, and searched for with boyer_moore_horspool; its skip table is built
+    only from fixed elements, so no match can be skipped. Where the anchor is
+    found, the rest of the fixed elements are compared. When most of the pattern
+    is fixed, the anchor is most of the pattern, and the search runs at nearly
+    the speed of boyer_moore_horspool on the whole pattern.
+
+    The wildcard positions are given by a sequence of bools, parallel to the
+    pattern; 'true' means "matches anything", and the element of the pattern at
+    that position is ignored. parse_signature builds both from a string of hex
+    bytes and "??".
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type.
+        * The requirements of boyer_moore_horspool
+*/
+
+    template <typename patIter, typename traits = detail::BM_traits<patIter> >
+    class boyer_moore_horspool_wildcard {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+    public:
+        /// \fn boyer_moore_horspool_wildcard ( patIter first, patIter last, wildIter wild_first )
+        /// \param first        The start of the pattern to search for (Random Access Iterator)
+        /// \param last         One past the end of the pattern
+        /// \param wild_first   The start of a sequence of bools, one for each element of the
+        ///                     pattern; true where the pattern matches any element
+        ///
+        template <typename wildIter>
+        boyer_moore_horspool_wildcard ( patIter first, patIter last, wildIter wild_first )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  wild_ ( wild_first, wild_first + k_pattern_length ),
+                  k_anchor_length ( longest_fixed_run ( wild_, anchor_first_ )),
+                  bmh_ ( pat_first + anchor_first_, pat_first + anchor_first_ + k_anchor_length ) {
+        //  The fixed elements that the anchor doesn't cover
+            for ( difference_type i = 0; i < k_pattern_length; ++i )
+                if ( !wild_ [ i ] && ( i < anchor_first_ || i >= anchor_first_ + k_anchor_length ))
+                    fixed_.push_back ( i );
+            }
+
+        ~boyer_moore_horspool_wildcard () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+            const corpusIter res = this->find_next ( corpus_first, corpus_last );
+            return res == corpus_last - k_pattern_length + 1 ? corpus_last : res;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) {            // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return out;
+
+            const corpusIter k_no_match = corpus_last - k_pattern_length + 1;
+            corpusIter curPos = corpus_first;
+            while (( curPos = this->find_next ( curPos, corpus_last )) != k_no_match ) {
+                *out++ = curPos;
+                const difference_type step = overlapping ? 1 : k_pattern_length;
+                if ( std::distance ( curPos, k_no_match ) <= step )
+                    break;
+                curPos += step;
+                }
+            return out;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        const std::vector<bool> wild_;
+        difference_type anchor_first_;          // the start of the longest run of fixed elements
+        const difference_type k_anchor_length;  // and its length
+        boyer_moore_horspool<patIter, traits> bmh_;
+        std::vector<difference_type> fixed_;    // the fixed elements outside the anchor
+
+    //  Find the longest run of 'false' in 'wild'; returns its length, and its start in 'start'
+        static difference_type longest_fixed_run ( const std::vector<bool> &wild, difference_type &start ) {
+            difference_type best = 0, run = 0;
+            start = 0;
+            for ( std::size_t i = 0; i < wild.size (); ++i ) {
+                run = wild [ i ] ? 0 : run + 1;
+                if ( run > best ) {
+                    best = run;
+                    start = i + 1 - run;
+                    }
+                }
+            return best;
+            }
+
+        template <typename corpusIter>
+        bool verify ( corpusIter matchStart ) const {
+            for ( std::size_t i = 0; i < fixed_.size (); ++i )
+                if ( !( pat_first [ fixed_ [ i ]] == matchStart [ fixed_ [ i ]] ))
+                    return false;
+            return true;
+            }
+
+        /// \fn find_next ( corpusIter from, corpusIter corpus_last )
+        /// \brief Finds the first match that starts at or after 'from'
+        ///
+        /// Returns the start of the match, or one past the last possible start
+        /// (corpus_last - pattern_length + 1) if there is none.
+        template <typename corpusIter>
+        corpusIter find_next ( corpusIter from, corpusIter corpus_last ) const {
+            const corpusIter k_no_match = corpus_last - k_pattern_length + 1;
+        //  All wildcards; everything matches
+            if ( k_anchor_length == 0 )
+                return from;
+
+        //  Search for the anchor where a match could have it
+            const corpusIter search_last = corpus_last - ( k_pattern_length - anchor_first_ - k_anchor_length );
+            corpusIter anchor = from + anchor_first_;
+            while (( anchor = bmh_ ( anchor, search_last )) != search_last ) {
+                const corpusIter matchStart = anchor - anchor_first_;
+                if ( this->verify ( matchStart ))
+                    return matchStart;
+                ++anchor;
+                }
+            return k_no_match;
+            }
+/// \endcond
+        };
+
+
+/// \fn parse_signature ( const std::string &sig, std::vector<T> &pattern, std::vector<bool> &wild )
+/// \brief Converts a signature, such as "4D 5A ?? ?? 50 45", into a pattern and its wildcards
+///
+/// \param sig      Pairs of hex digits (one element each), or "??" for "any element",
+///                 optionally separated by whitespace
+/// \param pattern  Receives the elements of the pattern (zero at the wildcards)
+/// \param wild     Receives true at the wildcards, false elsewhere
+///
+/// Throws non_hex_input if the signature contains anything else, and
+/// not_enough_input if it ends in the middle of an element.
+///
+    template <typename T>
+    void parse_signature ( const std::string &sig, std::vector<T> &pattern, std::vector<bool> &wild ) {
+        pattern.clear ();
+        wild.clear ();
+        std::string::const_iterator it = sig.begin ();
+        while ( true ) {
+            while ( it != sig.end () && ( *it == ' ' || *it == '\t' || *it == '\n' || *it == '\r' ))
+                ++it;
+            if ( it == sig.end ())
+                break;
+            if ( sig.end () - it < 2 )
+                BOOST_THROW_EXCEPTION ( not_enough_input ());
+            if ( it [ 0 ] == '?' && it [ 1 ] == '?' ) {
+                pattern.push_back ( T ());
+                wild.push_back ( true );
+                }
+            else {
+                const unsigned val = 16 * detail::hex_char_to_int ( it [ 0 ] ) + detail::hex_char_to_int ( it [ 1 ] );
+                pattern.push_back ( static_cast<T> ( val ));
+                wild.push_back ( false );
+                }
+            it += 2;
+            }
+        }
+
+
+/// \fn boyer_moore_horspool_wildcard_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last, wildIter wild_first )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param wild_first   The start of the wildcard flags (true for "match anything")
+///
+    template <typename patIter, typename corpusIter, typename wildIter>
+    corpusIter boyer_moore_horspool_wildcard_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last, wildIter wild_first ) {
+        boyer_moore_horspool_wildcard<patIter> bmhw ( pat_first, pat_last, wild_first );
+        return bmhw ( corpus_first, corpus_last );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_WILDCARD_SEARCH_HPP
@@ -0,0 +1,161 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_AC_TRAITS_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_AC_TRAITS_HPP
+
+#include <climits>      // for CHAR_BIT
+#include <vector>
+#include <utility>      // for std::pair
+#include <algorithm>    // for std::sort, std::lower_bound, std::fill, std::copy
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/algorithm/searching/detail/debugging.hpp>
+
+namespace boost { namespace algorithm { namespace detail {
+
+//
+//  Default implementations of the transition tables for Aho-Corasick
+//
+//  Both tables are built from a trie, given as a list of (key, child) pairs for
+//  every state, along with the failure link of each state, and the states in
+//  breadth-first order. The root is always state 0.
+//
+    template<typename key_type, typename state_type, bool /*useArray*/> class transition_table;
+
+//  General case for data searching other than bytes; store the edges of the trie
+//  for all the states in one sorted array, and follow the failure links at search time.
+    template<typename key_type, typename state_type>
+    class transition_table<key_type, state_type, false> {
+    private:
+        typedef std::pair<key_type, state_type> edge_type;
+        std::vector<std::size_t> first_edge_;   // edges for state s are [first_edge_[s], first_edge_[s+1])
+        std::vector<edge_type>   edges_;
+        std::vector<state_type>  fail_;
+
+        struct key_less {
+            bool operator () ( const edge_type &e, const key_type &k ) const { return e.first < k; }
+            };
+
+    //  Returns the child of 's' for the key 'k', or 's' if there is none.
+        state_type child ( state_type s, key_type key ) const {
+            typename std::vector<edge_type>::const_iterator first = edges_.begin () + first_edge_ [ s ];
+            typename std::vector<edge_type>::const_iterator last  = edges_.begin () + first_edge_ [ s + 1 ];
+            first = std::lower_bound ( first, last, key, key_less ());
+            return ( first != last && !( key < first->first )) ? first->second : s;
+            }
+
+    public:
+        template <typename Trie>
+        void build ( const Trie &trie, const std::vector<state_type> &fail, const std::vector<state_type> &/*order*/ ) {
+            first_edge_.resize ( trie.size () + 1 );
+            edges_.clear ();
+            for ( std::size_t s = 0; s < trie.size (); ++s ) {
+                first_edge_ [ s ] = edges_.size ();
+                edges_.insert ( edges_.end (), trie [ s ].begin (), trie [ s ].end ());
+                std::sort ( edges_.begin () + first_edge_ [ s ], edges_.end ());
+                }
+            first_edge_ [ trie.size () ] = edges_.size ();
+            fail_ = fail;
+            }
+
+        state_type next ( state_type s, key_type key ) const {
+            state_type t;
+            while (( t = child ( s, key )) == s && s != 0 )
+                s = fail_ [ s ];
+            return t;
+            }
+
+        void PrintTransitionTable () const {
+            std::cout << "Aho-Corasick transition table <compressed>:" << std::endl;
+            for ( std::size_t s = 0; s + 1 < first_edge_.size (); ++s ) {
+                std::cout << "  " << s << " (fail " << fail_ [ s ] << "):";
+                for ( std::size_t i = first_edge_ [ s ]; i < first_edge_ [ s + 1 ]; ++i )
+                    std::cout << " " << edges_ [ i ].first << "->" << edges_ [ i ].second;
+                std::cout << std::endl;
+                }
+            std::cout << std::endl;
+            }
+        };
+
+
+//  Special case small numeric values; precompute every transition (a DFA),
+//  so that the search is two array lookups per element of the corpus.
+//  The rows are indexed by the class of the element rather than by its value:
+//  the values that aren't in any pattern all lead the same way (back to the
+//  root), so they share class 0, and each value that is gets a class of its own.
+//  A row is then (distinct values in the patterns + 1) entries long, rather than 256.
+    template<typename key_type, typename state_type>
+    class transition_table<key_type, state_type, true> {
+    private:
+        typedef typename boost::make_unsigned<key_type>::type unsigned_key_type;
+        BOOST_STATIC_CONSTANT ( std::size_t, k_alphabet_size = 1U << (CHAR_BIT * sizeof(key_type)));
+        boost::uint16_t class_ [ k_alphabet_size ]; // the class of each value
+        std::size_t class_count_;
+        std::vector<state_type> delta_;     // class_count_ entries per state
+
+        std::size_t cell ( state_type s, key_type key ) const {
+            return s * class_count_ + class_ [ static_cast<unsigned_key_type> ( key ) ];
+            }
+
+    public:
+        transition_table () : class_count_ ( 1 ) {
+            std::fill ( class_, class_ + k_alphabet_size, 0 );
+            }
+
+        template <typename Trie>
+        void build ( const Trie &trie, const std::vector<state_type> &fail, const std::vector<state_type> &order ) {
+            for ( std::size_t s = 0; s < trie.size (); ++s )
+                for ( typename Trie::value_type::const_iterator e = trie [ s ].begin (); e != trie [ s ].end (); ++e )
+                    if ( class_ [ static_cast<unsigned_key_type> ( e->first ) ] == 0 )
+                        class_ [ static_cast<unsigned_key_type> ( e->first ) ] = static_cast<boost::uint16_t> ( class_count_++ );
+
+            delta_.assign ( trie.size () * class_count_, 0 );
+        //  Parents are visited before their children, so the failure state's row is already complete
+            for ( typename std::vector<state_type>::const_iterator it = order.begin (); it != order.end (); ++it ) {
+                const state_type s = *it;
+                if ( s != 0 )
+                    std::copy ( delta_.begin () + fail [ s ] * class_count_,
+                                delta_.begin () + fail [ s ] * class_count_ + class_count_,
+                                delta_.begin () + s * class_count_ );
+                for ( typename Trie::value_type::const_iterator e = trie [ s ].begin (); e != trie [ s ].end (); ++e )
+                    delta_ [ cell ( s, e->first ) ] = e->second;
+                }
+            }
+
+        state_type next ( state_type s, key_type key ) const {
+            return delta_ [ cell ( s, key ) ];
+            }
+
+        void PrintTransitionTable () const {
+            std::cout << "Aho-Corasick transition table <dense, " << class_count_ << " classes>:" << std::endl;
+            for ( std::size_t s = 0; s < delta_.size () / class_count_; ++s ) {
+                std::cout << "  " << s << ":";
+                for ( std::size_t k = 0; k < k_alphabet_size; ++k )
+                    if ( class_ [ k ] != 0 && delta_ [ s * class_count_ + class_ [ k ]] != 0 )
+                        std::cout << " " << k << "->" << delta_ [ s * class_count_ + class_ [ k ]];
+                std::cout << std::endl;
+                }
+            std::cout << std::endl;
+            }
+        };
+
+    template<typename key_type>
+    struct AC_traits {
+        typedef boost::uint32_t state_type;
+        typedef boost::algorithm::detail::transition_table<key_type, state_type,
+                boost::is_integral<key_type>::value && (sizeof(key_type)==1)> transition_table_t;
+        };
+
+}}} // namespaces
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_AC_TRAITS_HPP
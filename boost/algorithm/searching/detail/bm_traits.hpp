@@ -10,10 +10,15 @@
 #ifndef BOOST_ALGORITHM_SEARCH_DETAIL_BM_TRAITS_HPP
 #define BOOST_ALGORITHM_SEARCH_DETAIL_BM_TRAITS_HPP
 
+#include <algorithm>    // for std::fill_n
 #include <climits>      // for CHAR_BIT
 #include <vector>
+#include <limits>       // for std::numeric_limits
 #include <iterator>     // for std::iterator_traits
 
+#include <boost/cstdint.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/has_xxx.hpp>
 #include <boost/type_traits/make_unsigned.hpp>
 #include <boost/type_traits/is_integral.hpp>
 #include <boost/type_traits/remove_pointer.hpp>
@@ -24,7 +29,30 @@
 
 #include <boost/algorithm/searching/detail/debugging.hpp>
 
-namespace boost { namespace algorithm { namespace detail {
+namespace boost { namespace algorithm {
+
+//
+//  Folding policies for the B-M and B-M-H searchers. A fold maps each element to
+//  the key that is used in the skip table and in the comparisons; elements which
+//  fold to the same key match each other. The fold must return the type that it is
+//  passed, so that a byte pattern still gets an array-based skip table.
+//
+//  no_fold hands back a reference to the element, so that the default searchers
+//  compare the elements themselves, without copying them.
+    struct no_fold {
+        template <typename T>
+        static const T &apply ( const T &t ) { return t; }
+        };
+
+//  Case-insensitive matching for ASCII (or any character set where 'A'-'Z' are contiguous)
+    struct ascii_case_fold {
+        template <typename T>
+        static T apply ( T t ) {
+            return ( t >= T ( 'A' ) && t <= T ( 'Z' )) ? static_cast<T> ( t + ( 'a' - 'A' )) : t;
+            }
+        };
+
+namespace detail {
 
 //
 //  Default implementations of the skip tables for B-M and B-M-H
@@ -62,17 +90,31 @@ namespace boost { namespace algorithm { namespace detail {
         };
         
     
-//  Special case small numeric values; use an array
+//  Special case small numeric values (up to 16 bits); use an array.
+//  The 256 entries for a byte key live in the table itself; the 64K entries for
+//  a 16-bit key (512K of ptrdiff_t) are allocated, so that a searcher (or the
+//  free functions, which make one on the stack) stays small.
     template<typename key_type, typename value_type>
     class skip_table<key_type, value_type, true> {
     private:
         typedef typename boost::make_unsigned<key_type>::type unsigned_key_type;
-        typedef boost::array<value_type, 1U << (CHAR_BIT * sizeof(key_type))> skip_map;
+        BOOST_STATIC_CONSTANT ( std::size_t, k_size = std::size_t ( 1 ) << (CHAR_BIT * sizeof(key_type)));
+        typedef typename boost::mpl::if_c<sizeof(key_type) == 1,
+                    boost::array<value_type, k_size>,
+                    std::vector<value_type>
+                >::type skip_map;
         skip_map skip_;
         const value_type k_default_value;
+
+        static void init ( boost::array<value_type, k_size> &skip, value_type default_value ) {
+            std::fill_n ( skip.begin(), skip.size(), default_value );
+            }
+        static void init ( std::vector<value_type> &skip, value_type default_value ) {
+            skip.assign ( k_size, default_value );
+            }
     public:
-        skip_table ( std::size_t patSize, value_type default_value ) : k_default_value ( default_value ) {
-            std::fill_n ( skip_.begin(), skip_.size(), default_value );
+        skip_table ( std::size_t /*patSize*/, value_type default_value ) : k_default_value ( default_value ) {
+            init ( skip_, default_value );
             }
         
         void insert ( key_type key, value_type val ) {
@@ -92,14 +134,143 @@ namespace boost { namespace algorithm { namespace detail {
             }
         };
 
-    template<typename Iterator>
+//  Wider integral keys (wchar_t, int, token ids, etc); use an open-addressed hash table,
+//  sized for the pattern. Since there are at most patSize different keys, and the table
+//  is never more than half full, a lookup of a key that is not in the pattern (the
+//  common case) stops after looking at one or two slots.
+//  Empty slots hold 'empty_key_', a key value which is not in the table, and the default
+//  value - so a lookup of 'empty_key_' itself finds the default value.
+    template<typename key_type, typename value_type>
+    class compact_skip_table {
+    private:
+        typedef typename boost::make_unsigned<key_type>::type unsigned_key_type;
+        std::vector<key_type> keys_;
+        std::vector<value_type> values_;
+        const value_type k_default_value;
+        const std::size_t k_mask;
+        const int k_shift;
+        key_type empty_key_;
+
+        static std::size_t table_bits ( std::size_t patSize ) {
+            std::size_t bits = 2;
+            while (( std::size_t ( 1 ) << bits ) < 2 * patSize )
+                ++bits;
+            return bits;
+            }
+
+    //  Fibonacci hashing; the high bits of the product are the best mixed
+        std::size_t slot ( key_type key ) const {
+            const boost::uint64_t k_golden = ( boost::uint64_t ( 0x9E3779B9UL ) << 32 ) | 0x7F4A7C15UL;
+            const boost::uint64_t h = static_cast<boost::uint64_t> ( static_cast<unsigned_key_type> ( key )) * k_golden;
+            return static_cast<std::size_t> ( h >> k_shift );
+            }
+
+    //  Pick a new marker for the empty slots, because 'key' is about to be inserted
+        void replace_empty_key ( key_type key ) {
+            key_type candidate = key;
+            bool in_use = true;
+            while ( in_use ) {
+                candidate = static_cast<key_type> ( static_cast<unsigned_key_type> ( candidate ) + 1U );
+                in_use = candidate == key;
+                for ( std::size_t i = 0; !in_use && i < keys_.size (); ++i )
+                    in_use = keys_ [ i ] == candidate && keys_ [ i ] != empty_key_;
+                }
+            for ( std::size_t i = 0; i < keys_.size (); ++i )
+                if ( keys_ [ i ] == empty_key_ )
+                    keys_ [ i ] = candidate;
+            empty_key_ = candidate;
+            }
+
+    public:
+        compact_skip_table ( std::size_t patSize, value_type default_value )
+            : keys_ ( std::size_t ( 1 ) << table_bits ( patSize ), (std::numeric_limits<key_type>::max) ()),
+              values_ ( keys_.size (), default_value ), k_default_value ( default_value ),
+              k_mask ( keys_.size () - 1 ), k_shift ( 64 - static_cast<int> ( table_bits ( patSize ))),
+              empty_key_ ((std::numeric_limits<key_type>::max) ()) {}
+
+        void insert ( key_type key, value_type val ) {
+            if ( key == empty_key_ )
+                replace_empty_key ( key );
+            std::size_t i = slot ( key );
+            while ( keys_ [ i ] != key && keys_ [ i ] != empty_key_ )
+                i = ( i + 1 ) & k_mask;
+            keys_   [ i ] = key;
+            values_ [ i ] = val;
+            }
+
+        value_type operator [] ( key_type key ) const {
+            std::size_t i = slot ( key );
+            while ( true ) {
+                if ( keys_ [ i ] == key )
+                    return values_ [ i ];
+                if ( keys_ [ i ] == empty_key_ )
+                    return k_default_value;
+                i = ( i + 1 ) & k_mask;
+                }
+            }
+
+        void PrintSkipTable () const {
+            std::cout << "BM(H) Skip Table <open addressed, " << keys_.size () << " slots>:" << std::endl;
+            for ( std::size_t i = 0; i < keys_.size (); ++i )
+                if ( keys_ [ i ] != empty_key_ && values_ [ i ] != k_default_value )
+                    std::cout << "  " << keys_ [ i ] << ": " << values_ [ i ] << std::endl;
+            std::cout << std::endl;
+            }
+        };
+
+//  Choose a skip table for the key type:
+//      8 and 16 bit integral keys  - a flat array (at most 64K entries)
+//      wider integral keys         - compact_skip_table
+//      everything else             - skip_table<..., false> (unordered_map)
+    template<typename key_type, typename value_type>
+    struct select_skip_table {
+        BOOST_STATIC_CONSTANT ( bool, is_int = boost::is_integral<key_type>::value );
+        typedef typename boost::mpl::if_c<is_int && ( sizeof(key_type) <= 2 ),
+                    skip_table<key_type, value_type, true>,
+                    typename boost::mpl::if_c<is_int,
+                        compact_skip_table<key_type, value_type>,
+                        skip_table<key_type, value_type, false>
+                    >::type
+                >::type type;
+        };
+
+    template<typename Iterator, typename Fold = no_fold>
     struct BM_traits {
         typedef typename std::iterator_traits<Iterator>::difference_type value_type;
         typedef typename std::iterator_traits<Iterator>::value_type key_type;
-        typedef boost::algorithm::detail::skip_table<key_type, value_type, 
-                boost::is_integral<key_type>::value && (sizeof(key_type)==1)> skip_table_t;
+        typedef typename select_skip_table<key_type, value_type>::type skip_table_t;
+        typedef Fold fold_type;
+        };
+
+//  The fold to use for a set of traits; traits which don't say get no_fold
+    BOOST_MPL_HAS_XXX_TRAIT_DEF ( fold_type )
+
+    template<typename traits, bool = has_fold_type<traits>::value>
+    struct traits_fold {
+        typedef no_fold type;
+        };
+
+    template<typename traits>
+    struct traits_fold<traits, true> {
+        typedef typename traits::fold_type type;
         };
 
-}}} // namespaces
+}
+
+//
+//  The traits for a B-M or B-M-H search that folds the elements with 'Fold':
+//      boyer_moore<patIter, folding_traits<patIter, my_fold> >
+//  and for the common case, a search that ignores (ASCII) case:
+//      boyer_moore_horspool<const char *, case_insensitive_traits<const char *> >
+//  folding_traits<patIter> folds nothing; it behaves as the default traits do, and
+//  names them when a later template parameter (such as 'Stats') is given.
+//
+    template<typename Iterator, typename Fold = no_fold>
+    struct folding_traits : public detail::BM_traits<Iterator, Fold> {};
+
+    template<typename Iterator>
+    struct case_insensitive_traits : public detail::BM_traits<Iterator, ascii_case_fold> {};
+
+}} // namespaces
 
 #endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_BM_TRAITS_HPP
@@ -0,0 +1,175 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_SIMD_SEARCH_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_SIMD_SEARCH_HPP
+
+#include <cstddef>      // for std::size_t
+
+#include <boost/config.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+
+//  Define BOOST_ALGORITHM_NO_SIMD to disable the vectorized searches entirely.
+//
+//  SSE2 is part of the x86-64 baseline, so it is used whenever the compiler
+//  says it is available. The AVX2 kernel is compiled with a function-level target
+//  attribute, and is only selected at runtime, after asking the CPU.
+#if !defined(BOOST_ALGORITHM_NO_SIMD) && \
+    ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ))
+#define BOOST_ALGORITHM_SEARCH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2) && defined(__GNUC__) && \
+    ( defined(__clang__) || __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ))
+#define BOOST_ALGORITHM_SEARCH_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// \cond DOXYGEN_HIDE
+
+namespace boost { namespace algorithm { namespace detail {
+
+//  Can we search the corpus [first, last) using vector loads?
+//  We need a byte-sized integral element type, and contiguous storage.
+//  The only iterators that we know are contiguous are pointers.
+    template <typename value_type, typename corpusIter>
+    struct is_simd_searchable {
+#ifdef BOOST_ALGORITHM_SEARCH_SSE2
+        BOOST_STATIC_CONSTANT ( bool, value =
+            boost::is_integral<value_type>::value && sizeof(value_type) == 1 &&
+            boost::is_pointer<corpusIter>::value );
+#else
+        BOOST_STATIC_CONSTANT ( bool, value = false );
+#endif
+        };
+
+#ifdef BOOST_ALGORITHM_SEARCH_SSE2
+
+    inline unsigned simd_count_trailing_zeros ( unsigned mask ) {
+#ifdef _MSC_VER
+        unsigned long idx;
+        _BitScanForward ( &idx, mask );
+        return idx;
+#else
+        return __builtin_ctz ( mask );
+#endif
+        }
+
+//  Check a candidate, element by element. The two elements that the vector
+//  loop compared are checked again; that is cheaper than skipping them.
+    template <typename patIter>
+    inline bool simd_verify ( const unsigned char *candidate, patIter pat, std::size_t pat_len ) {
+        for ( std::size_t i = 0; i < pat_len; ++i )
+            if ( candidate [ i ] != static_cast<unsigned char> ( pat [ i ] ))
+                return false;
+        return true;
+        }
+
+    inline bool cpu_has_avx2 () {
+#ifdef BOOST_ALGORITHM_SEARCH_AVX2
+        return __builtin_cpu_supports ( "avx2" ) != 0;
+#else
+        return false;
+#endif
+        }
+
+//  The vectorized searches compare two elements of the pattern (at offsets 'off1'
+//  and 'off2'; by default, the first and the last) against 16 (or 32) consecutive
+//  positions of the corpus at once. Only the positions where both of them match
+//  are checked element by element.
+//
+//  Returns true if a match was found, and sets 'pos' to its offset.
+//  Otherwise, sets 'pos' to the first position that has not been examined;
+//  the caller is responsible for searching the rest of the corpus.
+//  Requires pat_len >= 2, and off1, off2 < pat_len.
+    template <typename patIter>
+    bool sse2_search ( const unsigned char *corpus, std::size_t corpus_len,
+                        patIter pat, std::size_t pat_len,
+                        std::size_t off1, std::size_t off2, std::size_t &pos ) {
+        const __m128i first = _mm_set1_epi8 ( static_cast<char> ( pat [ off1 ] ));
+        const __m128i last  = _mm_set1_epi8 ( static_cast<char> ( pat [ off2 ] ));
+
+        std::size_t i = 0;
+        for ( ; i + pat_len - 1 + 16 <= corpus_len; i += 16 ) {
+            const __m128i block_first = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( corpus + i + off1 ));
+            const __m128i block_last  = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( corpus + i + off2 ));
+            unsigned mask = _mm_movemask_epi8 ( _mm_and_si128 (
+                        _mm_cmpeq_epi8 ( first, block_first ), _mm_cmpeq_epi8 ( last, block_last )));
+            while ( mask != 0 ) {
+                const std::size_t candidate = i + simd_count_trailing_zeros ( mask );
+                if ( simd_verify ( corpus + candidate, pat, pat_len )) {
+                    pos = candidate;
+                    return true;
+                    }
+                mask &= mask - 1;
+                }
+            }
+
+        pos = i;
+        return false;
+        }
+
+    template <typename patIter>
+    bool sse2_search ( const unsigned char *corpus, std::size_t corpus_len,
+                        patIter pat, std::size_t pat_len, std::size_t &pos ) {
+        return sse2_search ( corpus, corpus_len, pat, pat_len, 0, pat_len - 1, pos );
+        }
+
+#ifdef BOOST_ALGORITHM_SEARCH_AVX2
+    template <typename patIter>
+    __attribute__ (( target ( "avx2" )))
+    bool avx2_search ( const unsigned char *corpus, std::size_t corpus_len,
+                        patIter pat, std::size_t pat_len,
+                        std::size_t off1, std::size_t off2, std::size_t &pos ) {
+        const __m256i first = _mm256_set1_epi8 ( static_cast<char> ( pat [ off1 ] ));
+        const __m256i last  = _mm256_set1_epi8 ( static_cast<char> ( pat [ off2 ] ));
+
+        std::size_t i = 0;
+        for ( ; i + pat_len - 1 + 32 <= corpus_len; i += 32 ) {
+            const __m256i block_first = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( corpus + i + off1 ));
+            const __m256i block_last  = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( corpus + i + off2 ));
+            unsigned mask = static_cast<unsigned> ( _mm256_movemask_epi8 ( _mm256_and_si256 (
+                        _mm256_cmpeq_epi8 ( first, block_first ), _mm256_cmpeq_epi8 ( last, block_last ))));
+            while ( mask != 0 ) {
+                const std::size_t candidate = i + simd_count_trailing_zeros ( mask );
+                if ( simd_verify ( corpus + candidate, pat, pat_len )) {
+                    pos = candidate;
+                    return true;
+                    }
+                mask &= mask - 1;
+                }
+            }
+
+    //  Let the 16-wide version pick up what's left before the scalar tail
+        std::size_t rest;
+        const bool found = sse2_search ( corpus + i, corpus_len - i, pat, pat_len, off1, off2, rest );
+        pos = i + rest;
+        return found;
+        }
+
+    template <typename patIter>
+    bool avx2_search ( const unsigned char *corpus, std::size_t corpus_len,
+                        patIter pat, std::size_t pat_len, std::size_t &pos ) {
+        return avx2_search ( corpus, corpus_len, pat, pat_len, 0, pat_len - 1, pos );
+        }
+#endif
+
+#endif  // BOOST_ALGORITHM_SEARCH_SSE2
+
+}}} // namespaces
+
+/// \endcond
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_SIMD_SEARCH_HPP
@@ -12,12 +12,14 @@
 
 #include <vector>
 #include <iterator>     // for std::iterator_traits
+#include <memory>       // for std::allocator
 
 #include <boost/assert.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits/is_same.hpp>
 
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/searching/search_stats.hpp>
 
 // #define  BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_DEBUG
 
@@ -34,16 +36,29 @@ namespace boost { namespace algorithm {
 
     http://en.wikipedia.org/wiki/Knuth–Morris–Pratt_algorithm
     http://www.inf.fh-flensburg.de/lang/algorithmen/pattern/kmpen.htm
+
+    The skip table is allocated with 'Alloc', which must allocate the
+    difference_type of the pattern iterator. A searcher can also be made from a
+    table that has already been built (the ones in a blob of searcher tables, for
+    example; see searcher_tables.hpp); 'Table' is then the type of a view of it,
+    which has an operator [].
+
+    'Stats' is an instrumentation policy; see search_stats.hpp.
 */
 
-    template <typename patIter>
-    class knuth_morris_pratt {
+    template <typename patIter,
+              typename Stats = no_search_stats,
+              typename Alloc = std::allocator<typename std::iterator_traits<patIter>::difference_type>,
+              typename Table = std::vector<typename std::iterator_traits<patIter>::difference_type, Alloc> >
+    class knuth_morris_pratt : private detail::search_stats_holder<Stats> {
         typedef typename std::iterator_traits<patIter>::difference_type difference_type;
     public:
-        knuth_morris_pratt ( patIter first, patIter last ) 
+        typedef Alloc allocator_type;
+
+        knuth_morris_pratt ( patIter first, patIter last, const Alloc &alloc = Alloc ())
                 : pat_first ( first ), pat_last ( last ), 
                   k_pattern_length ( std::distance ( pat_first, pat_last )),
-                  skip_ ( k_pattern_length + 1 ) {
+                  skip_ ( k_pattern_length + 1, difference_type (), alloc ) {
 #ifdef NEW_KMP
             preKmp ( pat_first, pat_last );
 #else
@@ -53,8 +68,23 @@ namespace boost { namespace algorithm {
             detail::PrintTable ( skip_.begin (), skip_.end ());
 #endif
             }
+
+        /// \fn knuth_morris_pratt ( patIter first, patIter last, const Table &table )
+        /// \brief Makes a searcher for the pattern from a skip table that has already been built
+        knuth_morris_pratt ( patIter first, patIter last, const Table &table )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  skip_ ( table ) {}
             
         ~knuth_morris_pratt () {}
+
+        /// \fn stats ()
+        /// \brief The counters kept by the 'Stats' policy
+        const Stats &stats () const { return this->counters (); }
+
+        /// \fn reset_stats ()
+        /// \brief Sets the counters kept by the 'Stats' policy back to zero
+        void reset_stats () { this->counters () = Stats (); }
         
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -79,11 +109,96 @@ namespace boost { namespace algorithm {
             return do_search   ( corpus_first, corpus_last, k_corpus_length );
             }
     
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern that was passed into the constructor
+        ///
+        /// The partial match state is carried from one match to the next, so the
+        /// corpus is scanned exactly once, even when matches overlap.
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type, 
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if ( pat_first == pat_last ) {                  // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length ) 
+                return out;
+
+            const difference_type last_match = k_corpus_length - k_pattern_length;
+            difference_type match_start = 0;
+            difference_type idx = 0;
+            while ( find_next ( corpus_first, last_match, match_start, idx )) {
+                *out++ = corpus_first + match_start;
+            //  Either keep the matched border of the pattern, or start over past the match
+                if ( overlapping )
+                    keep_border ( match_start, idx );
+                else {
+                    this->counters ().on_shift ( k_pattern_length );
+                    match_start += k_pattern_length;
+                    idx = 0;
+                    }
+                }
+            return out;
+            }
+
+        /// \class cursor
+        /// \brief Finds the matches in a corpus one at a time (see matches () in match_generator.hpp)
+        ///
+        /// Like find_all, the partial match is carried from one match to the next,
+        /// so the corpus is scanned once, however many matches are asked for.
+        template <typename corpusIter>
+        class cursor {
+        public:
+            cursor ( const knuth_morris_pratt &searcher, corpusIter corpus_first, corpusIter corpus_last )
+                    : searcher_ ( searcher ), corpus_first_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                      k_corpus_length ( std::distance ( corpus_first, corpus_last )),
+                      match_start_ ( 0 ), idx_ ( 0 ) {
+                BOOST_STATIC_ASSERT (( boost::is_same<
+                    typename std::iterator_traits<patIter>::value_type, 
+                    typename std::iterator_traits<corpusIter>::value_type>::value ));
+                }
+
+            /// \fn next ()
+            /// \brief Returns the next match, or corpus_last when there are no more
+            corpusIter next () {
+                if ( searcher_.k_pattern_length == 0 )      // empty pattern matches everywhere
+                    return match_start_ < k_corpus_length ? corpus_first_ + match_start_++ : corpus_last_;
+                if ( idx_ == searcher_.k_pattern_length )   // resume after the last match
+                    searcher_.keep_border ( match_start_, idx_ );
+                if ( searcher_.find_next ( corpus_first_, k_corpus_length - searcher_.k_pattern_length, match_start_, idx_ ))
+                    return corpus_first_ + match_start_;
+                return corpus_last_;
+                }
+
+        private:
+            const knuth_morris_pratt &searcher_;
+            const corpusIter corpus_first_, corpus_last_;
+            const difference_type k_corpus_length;
+            difference_type match_start_;
+            difference_type idx_;
+            };
+
     private:
 /// \cond DOXYGEN_HIDE
+        template <typename> friend class knuth_morris_pratt_stream;
+        friend class searcher_tables_writer;
+
         patIter pat_first, pat_last;
         const difference_type k_pattern_length;
-        std::vector <difference_type> skip_;
+        Table skip_;
 
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -119,24 +234,55 @@ namespace boost { namespace algorithm {
 //              idx is in the range 0 .. k_pattern_length
 //              match_start is in the range 0 .. k_corpus_length - k_pattern_length + 1
 
-            const difference_type last_match = k_corpus_length - k_pattern_length;
             difference_type idx = 0;          // position in the pattern we're comparing
+            if ( find_next ( corpus_first, k_corpus_length - k_pattern_length, match_start, idx ))
+                return corpus_first + match_start;
+#endif
+                
+        //  We didn't find anything
+            return corpus_last;
+            }
 
+        /// \fn find_next ( corpusIter corpus_first, difference_type last_match, 
+        ///                 difference_type &match_start, difference_type &idx )
+        /// \brief Resumes the search at 'match_start', with the first 'idx' elements 
+        ///        of the pattern already known to match
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param last_match   The last position in the corpus where a match can start
+        /// \param match_start  The position in the corpus that we're matching; updated
+        /// \param idx          The position in the pattern we're comparing; updated
+        ///
+        /// On success, 'match_start' is the position of the match and 'idx' is the pattern length.
+        template <typename corpusIter>
+        bool find_next ( corpusIter corpus_first, difference_type last_match,
+                difference_type &match_start, difference_type &idx ) const {
             while ( match_start <= last_match ) {
+                const difference_type k_known = idx;
                 while ( pat_first [ idx ] == corpus_first [ match_start + idx ] ) {
-                    if ( ++idx == k_pattern_length )
-                        return corpus_first + match_start;
+                    if ( ++idx == k_pattern_length ) {
+                        this->counters ().on_compare ( idx - k_known );
+                        return true;
+                        }
                     }
+                this->counters ().on_compare ( idx - k_known + 1 );
             //  Figure out where to start searching again
            //   assert ( idx - skip_ [ idx ] > 0 ); // we're always moving forward
+                this->counters ().on_lookup ( 1 );
+                this->counters ().on_shift ( idx - skip_ [ idx ] );
                 match_start += idx - skip_ [ idx ];
                 idx = skip_ [ idx ] >= 0 ? skip_ [ idx ] : 0;
            //   assert ( idx >= 0 && idx < k_pattern_length );
                 }
-#endif
-                
-        //  We didn't find anything
-            return corpus_last;
+            return false;
+            }
+
+    //  After a match, go on from the longest border of the pattern (which still matches)
+        void keep_border ( difference_type &match_start, difference_type &idx ) const {
+            this->counters ().on_lookup ( 1 );
+            this->counters ().on_shift ( idx - skip_ [ idx ] );
+            match_start += idx - skip_ [ idx ];
+            idx = skip_ [ idx ];
             }
     
 
@@ -195,6 +341,26 @@ namespace boost { namespace algorithm {
         knuth_morris_pratt<patIter> kmp ( pat_first, pat_last );
         return kmp ( corpus_first, corpus_last );
         }
+
+/// \fn knuth_morris_pratt_find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+///       patIter pat_first, patIter pat_last, OutputIterator out, bool overlapping )
+/// \brief Searches the corpus for every occurrence of the pattern.
+/// 
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param out          An output iterator which receives an iterator to the start of each match
+/// \param overlapping  If false, matches that overlap an earlier match are not reported
+///
+    template <typename patIter, typename corpusIter, typename OutputIterator>
+    OutputIterator knuth_morris_pratt_find_all ( 
+            corpusIter corpus_first, corpusIter corpus_last, 
+            patIter pat_first, patIter pat_last,
+            OutputIterator out, bool overlapping = true ) {
+        knuth_morris_pratt<patIter> kmp ( pat_first, pat_last );
+        return kmp.find_all ( corpus_first, corpus_last, out, overlapping );
+        }
 }}
 
 #endif  // BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_SEARCH_HPP
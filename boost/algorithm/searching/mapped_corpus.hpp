@@ -0,0 +1,168 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  mapped_corpus.hpp
+/// \brief A read-only, memory-mapped file that can be used as the corpus for
+///     any of the searches, without copying it into memory first.
+/// \author Marshall Clow
+
+#ifndef BOOST_ALGORITHM_MAPPED_CORPUS_HPP
+#define BOOST_ALGORITHM_MAPPED_CORPUS_HPP
+
+#include <cstddef>      // for std::size_t
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/exception/errinfo_errno.hpp>
+#include <boost/exception/errinfo_file_name.hpp>
+
+#ifdef BOOST_HAS_UNISTD_H
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace boost { namespace algorithm {
+
+/*!
+    \struct mapped_corpus_error
+    \brief  Thrown when a file cannot be opened, examined or mapped.
+            Carries the file name and (where available) the value of errno.
+*/
+struct mapped_corpus_error: virtual boost::exception, virtual std::exception {};
+
+/*
+    A file, mapped read-only into memory, presented as a range of 'charT'.
+
+    The iterators are pointers, so the mapped file can be passed directly to the
+    searcher objects (and to the vectorized searches, which need contiguous storage).
+    On POSIX systems, the file is mapped with mmap, and the kernel is told how the
+    mapping will be accessed (by default, sequentially; so it can read ahead aggressively).
+    Elsewhere, the file is read into memory.
+
+    If the size of the file is not a multiple of sizeof(charT), the extra bytes at
+    the end are not part of the range.
+*/
+
+    template <typename charT>
+    class basic_mapped_corpus : boost::noncopyable {
+    public:
+        typedef charT           value_type;
+        typedef const charT *   iterator;
+        typedef const charT *   const_iterator;
+        typedef std::size_t     size_type;
+        typedef std::ptrdiff_t  difference_type;
+
+        /// How the searches will access the file (passed to madvise)
+        enum access_pattern { normal_access, sequential_access, random_access };
+
+        /// \fn basic_mapped_corpus ( const char *path, access_pattern access )
+        /// \brief Maps the file at 'path' into memory
+        ///
+        /// \param path     The name of the file to map
+        /// \param access   How the file will be accessed
+        ///
+        explicit basic_mapped_corpus ( const char *path, access_pattern access = sequential_access )
+                : data_ ( NULL ), size_ ( 0 ), mapped_bytes_ ( 0 ) {
+            this->open ( path, access );
+            }
+
+        explicit basic_mapped_corpus ( const std::string &path, access_pattern access = sequential_access )
+                : data_ ( NULL ), size_ ( 0 ), mapped_bytes_ ( 0 ) {
+            this->open ( path.c_str (), access );
+            }
+
+        ~basic_mapped_corpus () {
+#ifdef BOOST_HAS_UNISTD_H
+            if ( mapped_bytes_ != 0 )
+                (void) ::munmap ( const_cast<charT *> ( data_ ), mapped_bytes_ );
+#endif
+            }
+
+        const_iterator begin () const { return data_; }
+        const_iterator end   () const { return data_ + size_; }
+        size_type      size  () const { return size_; }
+        bool           empty () const { return size_ == 0; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const charT *data_;
+        size_type size_;
+        std::size_t mapped_bytes_;
+        std::vector<charT> buffer_;     // used when we can't map the file
+
+        void fail ( const char *path, int err ) {
+            BOOST_THROW_EXCEPTION ( mapped_corpus_error ()
+                        << boost::errinfo_file_name ( path ) << boost::errinfo_errno ( err ));
+            }
+
+#ifdef BOOST_HAS_UNISTD_H
+        void open ( const char *path, access_pattern access ) {
+            const int fd = ::open ( path, O_RDONLY );
+            if ( fd < 0 )
+                this->fail ( path, errno );
+
+            struct stat st;
+            if ( ::fstat ( fd, &st ) != 0 ) {
+                const int err = errno;
+                (void) ::close ( fd );
+                this->fail ( path, err );
+                }
+
+        //  mmap won't map an empty file; we don't need it to.
+            if ( st.st_size > 0 ) {
+                void *p = ::mmap ( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+                if ( p == MAP_FAILED ) {
+                    const int err = errno;
+                    (void) ::close ( fd );
+                    this->fail ( path, err );
+                    }
+                mapped_bytes_ = st.st_size;
+                data_ = static_cast<const charT *> ( p );
+                size_ = mapped_bytes_ / sizeof ( charT );
+                (void) ::madvise ( p, mapped_bytes_,
+                        access == sequential_access ? MADV_SEQUENTIAL :
+                        access == random_access     ? MADV_RANDOM : MADV_NORMAL );
+                }
+
+        //  The mapping stays valid after the file is closed
+            (void) ::close ( fd );
+            }
+#else
+        void open ( const char *path, access_pattern /*access*/ ) {
+            std::ifstream in ( path, std::ios_base::binary | std::ios_base::in );
+            if ( !in )
+                this->fail ( path, errno );
+            in.seekg ( 0, std::ios_base::end );
+            const std::streamoff bytes = in.tellg ();
+            in.seekg ( 0, std::ios_base::beg );
+            buffer_.resize ( static_cast<std::size_t> ( bytes ) / sizeof ( charT ));
+            if ( !buffer_.empty ())
+                in.read ( reinterpret_cast<char *> ( &buffer_ [ 0 ] ), buffer_.size () * sizeof ( charT ));
+            if ( !in )
+                this->fail ( path, errno );
+            data_ = buffer_.empty () ? NULL : &buffer_ [ 0 ];
+            size_ = buffer_.size ();
+            }
+#endif
+/// \endcond
+        };
+
+    typedef basic_mapped_corpus<char> mapped_corpus;
+
+}}
+
+#endif  //  BOOST_ALGORITHM_MAPPED_CORPUS_HPP
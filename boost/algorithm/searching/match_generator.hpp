@@ -0,0 +1,304 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_MATCH_GENERATOR_HPP
+#define BOOST_ALGORITHM_MATCH_GENERATOR_HPP
+
+#include <boost/config.hpp>
+
+//  The generators are C++20 coroutines
+#if defined(__has_include)
+#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define BOOST_ALGORITHM_SEARCH_COROUTINES
+#endif
+#endif
+
+#ifdef BOOST_ALGORITHM_SEARCH_COROUTINES
+
+#include <coroutine>
+#include <exception>    // for std::exception_ptr
+#include <iterator>     // for std::iterator_traits, std::default_sentinel_t, std::back_inserter
+#include <memory>       // for std::addressof
+#include <utility>      // for std::exchange
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/empty.hpp>
+#include <boost/range/iterator.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Coroutines that produce the matches of a search one at a time, as they are
+    needed, rather than writing them all to an output iterator.
+
+    matches ( searcher, corpus ) returns a match_generator, a range of the
+    iterators to the start of each match, which can be used with a range-based
+    for loop. The search runs up to the first match, and stops; each increment
+    of the generator's iterator resumes it from one past the last match. Any
+    searcher with the usual operator () ( corpus_first, corpus_last ) works.
+    Overlapping matches are all reported; since an empty pattern matches at
+    every position, so is each position of the corpus.
+
+    A searcher that has a nested cursor class template (knuth_morris_pratt,
+    shift_or and boyer_moore) keeps its state from one match to the next in
+    the cursor - the matched border of the pattern, the state word, or Galil's
+    rule - so finding every match takes the same linear time as find_all, even
+    when the matches overlap heavily (a periodic pattern in a periodic corpus).
+    For any other searcher, each resumption is a new call to the searcher, one
+    past the last match; that is fine for matches that are far apart, but can
+    take O(n * m) time for heavily overlapping ones.
+
+    async_matches ( stream_searcher, source ) searches a stream that arrives in
+    chunks, with one of the stream searchers (see stream_search.hpp), and returns
+    an async_match_generator of the stream offsets of the matches. The source
+    has a member function next (), which returns an awaitable whose result is
+    the next chunk (a range); an empty chunk marks the end of the stream. A
+    consumer, itself a coroutine, gets each match with
+        while ( boost::optional<position_type> pos = co_await gen.next ())
+    While the source is waiting for a chunk, both coroutines are suspended,
+    and the thread is free to do other work. A chunk only has to remain valid
+    until the next call to the source's next (); the matches in it are kept
+    until the consumer asks for them.
+
+    The searcher, the corpus and the source are not copied; they must outlive
+    the generator.
+*/
+
+    template <typename T>
+    class match_generator {
+    public:
+        struct promise_type {
+            const T *value_;
+            std::exception_ptr error_;
+
+            match_generator get_return_object () {
+                return match_generator ( std::coroutine_handle<promise_type>::from_promise ( *this ));
+                }
+            std::suspend_always initial_suspend () noexcept { return {}; }
+            std::suspend_always final_suspend   () noexcept { return {}; }
+            std::suspend_always yield_value ( const T &value ) noexcept {
+                value_ = std::addressof ( value );
+                return {};
+                }
+            void return_void () noexcept {}
+            void unhandled_exception () { error_ = std::current_exception (); }
+
+        //  A match_generator can't wait for anything
+            template <typename U>
+            std::suspend_never await_transform ( U && ) = delete;
+            };
+
+        class iterator {
+        public:
+            typedef std::input_iterator_tag iterator_category;
+            typedef T                       value_type;
+            typedef std::ptrdiff_t          difference_type;
+            typedef const T *               pointer;
+            typedef const T &               reference;
+
+            iterator () : coro_ ( nullptr ) {}
+            explicit iterator ( std::coroutine_handle<promise_type> coro ) : coro_ ( coro ) {}
+
+            reference operator *  () const { return *coro_.promise ().value_; }
+            pointer   operator -> () const { return  coro_.promise ().value_; }
+
+            iterator &operator ++ () {
+                coro_.resume ();
+                rethrow ();
+                return *this;
+                }
+            void operator ++ ( int ) { ++*this; }
+
+            friend bool operator == ( const iterator &it, std::default_sentinel_t ) {
+                return !it.coro_ || it.coro_.done ();
+                }
+
+        private:
+            friend class match_generator;
+            void rethrow () const {
+                if ( coro_.done () && coro_.promise ().error_ )
+                    std::rethrow_exception ( coro_.promise ().error_ );
+                }
+            std::coroutine_handle<promise_type> coro_;
+            };
+
+        match_generator ( match_generator &&other ) noexcept : coro_ ( std::exchange ( other.coro_, nullptr )) {}
+        match_generator &operator = ( match_generator &&other ) noexcept {
+            if ( this != &other ) {
+                if ( coro_ ) coro_.destroy ();
+                coro_ = std::exchange ( other.coro_, nullptr );
+                }
+            return *this;
+            }
+        ~match_generator () { if ( coro_ ) coro_.destroy (); }
+
+        /// \fn begin ()
+        /// \brief Runs the search up to the first match; may only be called once
+        iterator begin () {
+            iterator it ( coro_ );
+            if ( coro_ ) {
+                coro_.resume ();
+                it.rethrow ();
+                }
+            return it;
+            }
+
+        std::default_sentinel_t end () const { return std::default_sentinel; }
+
+    private:
+        explicit match_generator ( std::coroutine_handle<promise_type> coro ) : coro_ ( coro ) {}
+        match_generator ( const match_generator & ) = delete;
+        match_generator &operator = ( const match_generator & ) = delete;
+
+        std::coroutine_handle<promise_type> coro_;
+        };
+
+
+    template <typename T>
+    class async_match_generator {
+    public:
+        struct promise_type {
+            const T *value_;
+            std::exception_ptr error_;
+            std::coroutine_handle<> consumer_;
+
+        //  Yielding a match (or finishing) resumes the consumer that asked for it
+            struct resume_consumer {
+                bool await_ready () const noexcept { return false; }
+                std::coroutine_handle<> await_suspend ( std::coroutine_handle<promise_type> coro ) noexcept {
+                    return coro.promise ().consumer_;
+                    }
+                void await_resume () const noexcept {}
+                };
+
+            async_match_generator get_return_object () {
+                return async_match_generator ( std::coroutine_handle<promise_type>::from_promise ( *this ));
+                }
+            std::suspend_always initial_suspend () noexcept { return {}; }
+            resume_consumer     final_suspend   () noexcept { return {}; }
+            resume_consumer yield_value ( const T &value ) noexcept {
+                value_ = std::addressof ( value );
+                return {};
+                }
+            void return_void () noexcept { value_ = nullptr; }
+            void unhandled_exception () { value_ = nullptr; error_ = std::current_exception (); }
+            };
+
+        class next_awaiter {
+        public:
+            explicit next_awaiter ( std::coroutine_handle<promise_type> coro ) : coro_ ( coro ) {}
+
+            bool await_ready () const noexcept { return !coro_ || coro_.done (); }
+            std::coroutine_handle<> await_suspend ( std::coroutine_handle<> consumer ) noexcept {
+                coro_.promise ().consumer_ = consumer;
+                return coro_;
+                }
+            boost::optional<T> await_resume () const {
+                if ( !coro_ )
+                    return boost::optional<T> ();
+                if ( coro_.promise ().error_ )
+                    std::rethrow_exception ( std::exchange ( coro_.promise ().error_, nullptr ));
+                if ( coro_.done ())
+                    return boost::optional<T> ();
+                return boost::optional<T> ( *coro_.promise ().value_ );
+                }
+
+        private:
+            std::coroutine_handle<promise_type> coro_;
+            };
+
+        async_match_generator ( async_match_generator &&other ) noexcept : coro_ ( std::exchange ( other.coro_, nullptr )) {}
+        async_match_generator &operator = ( async_match_generator &&other ) noexcept {
+            if ( this != &other ) {
+                if ( coro_ ) coro_.destroy ();
+                coro_ = std::exchange ( other.coro_, nullptr );
+                }
+            return *this;
+            }
+        ~async_match_generator () { if ( coro_ ) coro_.destroy (); }
+
+        /// \fn next ()
+        /// \brief Returns an awaitable for the next match; its result is empty at the end of the stream
+        next_awaiter next () { return next_awaiter ( coro_ ); }
+
+    private:
+        explicit async_match_generator ( std::coroutine_handle<promise_type> coro ) : coro_ ( coro ) {}
+        async_match_generator ( const async_match_generator & ) = delete;
+        async_match_generator &operator = ( const async_match_generator & ) = delete;
+
+        std::coroutine_handle<promise_type> coro_;
+        };
+
+
+/// \fn matches ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last )
+/// \brief Returns a generator of the matches of the searcher's pattern in the corpus
+///
+/// \param searcher     The searcher to use; a boyer_moore object, for example
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+///
+    template <typename Searcher, typename corpusIter>
+    match_generator<corpusIter> matches ( const Searcher &searcher,
+                                corpusIter corpus_first, corpusIter corpus_last ) {
+        if constexpr ( requires { typename Searcher::template cursor<corpusIter>; } ) {
+            typename Searcher::template cursor<corpusIter> cur ( searcher, corpus_first, corpus_last );
+            for ( corpusIter found = cur.next (); found != corpus_last; found = cur.next ())
+                co_yield found;
+            }
+        else {
+            while ( corpus_first != corpus_last ) {
+                const corpusIter found = searcher ( corpus_first, corpus_last );
+                if ( found == corpus_last )
+                    break;
+                co_yield found;
+                corpus_first = found;
+                ++corpus_first;
+                }
+            }
+        }
+
+    template <typename Searcher, typename Range>
+    match_generator<typename boost::range_iterator<Range>::type>
+    matches ( const Searcher &searcher, Range &corpus ) {
+        return matches ( searcher, boost::begin ( corpus ), boost::end ( corpus ));
+        }
+
+
+/// \fn async_matches ( StreamSearcher &searcher, ChunkSource &source )
+/// \brief Returns a generator of the stream offsets of the matches in the chunks from 'source'
+///
+/// \param searcher     A stream searcher; a boyer_moore_horspool_stream object, for example
+/// \param source       Its member function next () returns an awaitable of the next chunk,
+///                     which is empty at the end of the stream
+///
+    template <typename StreamSearcher, typename ChunkSource>
+    async_match_generator<typename StreamSearcher::position_type>
+    async_matches ( StreamSearcher &searcher, ChunkSource &source ) {
+        typedef typename StreamSearcher::position_type position_type;
+        std::vector<position_type> found;
+        while ( true ) {
+            auto &&chunk = co_await source.next ();
+            if ( boost::empty ( chunk ))
+                break;
+            found.clear ();
+            searcher.feed ( boost::begin ( chunk ), boost::end ( chunk ), std::back_inserter ( found ));
+            for ( typename std::vector<position_type>::const_iterator iter = found.begin (); iter != found.end (); ++iter )
+                co_yield *iter;
+            }
+        }
+
+}}
+
+#endif  // BOOST_ALGORITHM_SEARCH_COROUTINES
+
+#endif  //  BOOST_ALGORITHM_MATCH_GENERATOR_HPP
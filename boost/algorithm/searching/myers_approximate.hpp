@@ -0,0 +1,238 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_MYERS_APPROXIMATE_SEARCH_HPP
+#define BOOST_ALGORITHM_MYERS_APPROXIMATE_SEARCH_HPP
+
+#include <climits>      // for CHAR_BIT
+#include <iterator>     // for std::iterator_traits
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/optional.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Approximate searching, using Myers' bit-vector algorithm.
+
+    Finds the places where the corpus contains the pattern with at most
+    'max_distance' edits (insertions, deletions and substitutions). For each
+    element of the corpus, the searcher computes the smallest edit distance between
+    the pattern and any substring of the corpus that ends there; the column of the
+    dynamic programming table is kept as bit vectors of differences, so each
+    element of the corpus costs a handful of word operations per 64 pattern elements.
+
+    A match is reported by where it ends (one past its last element) and its edit
+    distance; a match of distance d ending at 'last' starts somewhere between
+    last - (pattern_length + d) and last - (pattern_length - d). When one place in
+    the corpus is close to the pattern, several neighbouring end positions are
+    usually reported (an exact match at 'last' is also a match of distance 1 at
+    last - 1 and last + 1).
+
+    The pattern is preprocessed once, when the searcher is built; the searcher
+    can then be used on any number of corpora.
+
+    Requirements:
+        * Random access iterators for the pattern; forward iterators for the corpus
+        * The two iterator types must "point to" the same underlying type.
+        * Additional requirements may be imposed by the skip table, such as:
+        ** Numeric type (array-based table)
+        ** Hashable type (map-based table)
+
+    G. Myers, "A fast bit-vector algorithm for approximate string matching
+        based on dynamic programming", J. ACM 46 (1999)
+    H. Hyyro, "A bit-vector algorithm for computing Levenshtein and Damerau
+        edit distances", Nordic Journal of Computing 10 (2003) (the blocked version)
+*/
+
+    template <typename Iter>
+    struct approximate_match {
+        approximate_match () : last (), distance ( 0 ) {}
+        approximate_match ( Iter l, std::size_t d ) : last ( l ), distance ( d ) {}
+
+        Iter last;              // one past the end of the match
+        std::size_t distance;   // the edit distance between the pattern and the match
+        };
+
+    template <typename Iter>
+    bool operator == ( const approximate_match<Iter> &lhs, const approximate_match<Iter> &rhs ) {
+        return lhs.last == rhs.last && lhs.distance == rhs.distance;
+        }
+
+    template <typename patIter, typename traits = detail::BM_traits<patIter> >
+    class myers_approximate {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef boost::uint64_t word_type;
+    public:
+        myers_approximate ( patIter first, patIter last, std::size_t max_distance )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  k_max_distance ( max_distance ),
+                  k_blocks ( ( k_pattern_length + k_word_bits - 1 ) / k_word_bits ),
+                  symbols_ ( k_pattern_length, 0 ) {
+        //  Number the different elements of the pattern; zero is "not in the pattern"
+            difference_type num_symbols = 1;
+            for ( patIter iter = first; iter != last; ++iter )
+                if ( symbols_ [ *iter ] == 0 )
+                    symbols_.insert ( *iter, num_symbols++ );
+
+        //  For each one, a bit vector of where it is in the pattern
+            peq_.assign ( num_symbols * k_blocks, word_type ( 0 ));
+            for ( difference_type i = 0; i < k_pattern_length; ++i )
+                peq_ [ symbols_ [ first [ i ]] * k_blocks + i / k_word_bits ] |= word_type ( 1 ) << ( i % k_word_bits );
+            }
+
+        ~myers_approximate () {}
+
+        std::size_t max_distance () const { return k_max_distance; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the first approximate match of the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Forward Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        /// Returns the first match (the one that ends first), or nothing.
+        template <typename corpusIter>
+        boost::optional<approximate_match<corpusIter> >
+        operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            approximate_match<corpusIter> res;
+            approximate_match<corpusIter> *res_last = this->scan ( corpus_first, corpus_last, &res, true );
+            if ( res_last == &res )
+                return boost::none;
+            return res;
+            }
+
+        template <typename Range>
+        boost::optional<approximate_match<typename boost::range_iterator<Range>::type> >
+        operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out )
+        /// \brief Searches the corpus for every approximate match of the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Forward Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an approximate_match<corpusIter>
+        ///                     for each position where a match ends
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out ) const {
+            return this->scan ( corpus_first, corpus_last, out, false );
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        BOOST_STATIC_CONSTANT ( difference_type, k_word_bits = sizeof ( word_type ) * CHAR_BIT );
+
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        const std::size_t k_max_distance;
+        const difference_type k_blocks;
+        typename traits::skip_table_t symbols_;
+        std::vector<word_type> peq_;        // [ symbol * k_blocks + block ]
+
+    //  Advance one block of the column by one element of the corpus. 'hin' is the
+    //  horizontal difference coming in at the top of the block (-1, 0 or +1); returns
+    //  the one going out at 'out_bit' (the bottom of the block, or the last pattern row).
+        static int advance ( word_type &Pv, word_type &Mv, word_type Eq, int hin, word_type out_bit ) {
+            const word_type hin_neg = hin < 0 ? 1 : 0;
+            const word_type Xv = Eq | Mv;
+            Eq |= hin_neg;
+            const word_type Xh = ((( Eq & Pv ) + Pv ) ^ Pv ) | Eq;
+            word_type Ph = Mv | ~( Xh | Pv );
+            word_type Mh = Pv & Xh;
+            const int hout = ( Ph & out_bit ) ? 1 : ( Mh & out_bit ) ? -1 : 0;
+            Ph = ( Ph << 1 ) | ( hin > 0 ? 1 : 0 );
+            Mh = ( Mh << 1 ) | hin_neg;
+            Pv = Mh | ~( Xv | Ph );
+            Mv = Ph & Xv;
+            return hout;
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator scan ( corpusIter corpus_first, corpusIter corpus_last,
+                                OutputIterator out, bool first_only ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) {            // empty pattern matches at start
+                *out++ = approximate_match<corpusIter> ( corpus_first, 0 );
+                return out;
+                }
+
+            const word_type k_high_bit = word_type ( 1 ) << ( k_word_bits - 1 );
+            const word_type k_last_bit = word_type ( 1 ) << (( k_pattern_length - 1 ) % k_word_bits );
+            std::size_t score = k_pattern_length;   // the distance to the empty string
+
+        //  The common case; the pattern fits in one word
+            if ( k_blocks == 1 ) {
+                word_type Pv = ~word_type ( 0 ), Mv = 0;
+                for ( corpusIter curPos = corpus_first; curPos != corpus_last; ) {
+                    score += advance ( Pv, Mv, peq_ [ symbols_ [ *curPos++ ]], 0, k_last_bit );
+                    if ( score <= k_max_distance ) {
+                        *out++ = approximate_match<corpusIter> ( curPos, score );
+                        if ( first_only ) break;
+                        }
+                    }
+                return out;
+                }
+
+        //  Longer patterns; pass the horizontal difference from each block to the next
+            std::vector<word_type> Pv ( k_blocks, ~word_type ( 0 )), Mv ( k_blocks, 0 );
+            for ( corpusIter curPos = corpus_first; curPos != corpus_last; ) {
+                const word_type *Eq = &peq_ [ symbols_ [ *curPos++ ] * k_blocks ];
+                int carry = 0;  // the top row of the table is all zeros
+                for ( difference_type b = 0; b < k_blocks - 1; ++b )
+                    carry = advance ( Pv [ b ], Mv [ b ], Eq [ b ], carry, k_high_bit );
+                score += advance ( Pv [ k_blocks - 1 ], Mv [ k_blocks - 1 ], Eq [ k_blocks - 1 ], carry, k_last_bit );
+                if ( score <= k_max_distance ) {
+                    *out++ = approximate_match<corpusIter> ( curPos, score );
+                    if ( first_only ) break;
+                    }
+                }
+            return out;
+            }
+/// \endcond
+        };
+
+
+/// \fn myers_approximate_find_all ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last, std::size_t max_distance, OutputIterator out )
+/// \brief Searches the corpus for every approximate match of the pattern.
+///
+/// \param corpus_first The start of the data to search (Forward Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param max_distance The largest edit distance to report
+/// \param out          An output iterator which receives an approximate_match<corpusIter> for each match
+///
+    template <typename patIter, typename corpusIter, typename OutputIterator>
+    OutputIterator myers_approximate_find_all (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last,
+            std::size_t max_distance, OutputIterator out ) {
+        myers_approximate<patIter> ma ( pat_first, pat_last, max_distance );
+        return ma.find_all ( corpus_first, corpus_last, out );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_MYERS_APPROXIMATE_SEARCH_HPP
@@ -0,0 +1,452 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_PARALLEL_SEARCH_HPP
+#define BOOST_ALGORITHM_PARALLEL_SEARCH_HPP
+
+#include <deque>
+#include <vector>
+#include <algorithm>    // for std::min, std::max, std::copy
+#include <iterator>     // for std::iterator_traits, std::back_inserter
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/once.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Multi-threaded searching of a single large corpus.
+
+    The corpus is split into chunks, and each chunk is searched by one of a
+    group of worker threads, using the same (const) searcher object - so the
+    tables are built once, and shared by all the threads. Neighboring chunks
+    overlap by pattern_length-1 elements, so that matches which straddle the
+    boundary are found. Each match is owned by the chunk that it starts in.
+
+    The workers take chunks in order from the start of the corpus. Once a match
+    has been found, chunks further along the corpus are not searched by
+    parallel_search, because they cannot contain the leftmost match.
+
+    The searcher can be any of the searcher objects in this library (or anything
+    else with the same operator ()); parallel_find_all also requires find_all.
+    The corpus must be a random access range, and must not change during the search.
+
+    The caller supplies the pattern length, because the searcher objects don't expose it.
+    If it is too short, matches that straddle two chunks are missed, and if it is
+    too long, matches in the overlaps are found twice; so the first match in each
+    chunk is used to check it against the searcher, and parallel_search_error is
+    thrown if they disagree.
+
+    The worker threads belong to a search_thread_pool, which is started once and
+    kept for many searches; the calling thread works too. A pool can be passed in,
+    or a shared one (with one thread per processor) is started by the first
+    search that needs it. Handing the chunks out still costs a few microseconds,
+    so for a small corpus, call the searcher directly. A search must not be
+    started from a task running on the same pool; it would wait for itself.
+*/
+
+/*!
+    \struct parallel_search_error
+    \brief  Thrown when the pattern length passed to parallel_search or
+            parallel_find_all doesn't agree with the searcher.
+*/
+struct parallel_search_error: virtual boost::exception, virtual std::exception {};
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    template <typename Searcher, typename corpusIter>
+    class parallel_search_state {
+        typedef typename std::iterator_traits<corpusIter>::difference_type difference_type;
+    public:
+        parallel_search_state ( const Searcher &s, corpusIter first, corpusIter last,
+                                difference_type pattern_length, difference_type chunk_size, bool stop_early )
+            : searcher_ ( s ), corpus_first ( first ), corpus_last ( last ),
+              k_pattern_length ( pattern_length ), k_overlap ( pattern_length > 0 ? pattern_length - 1 : 0 ),
+              k_chunk_size ( chunk_size ),
+              k_chunk_count (( std::distance ( first, last ) + chunk_size - 1 ) / chunk_size ),
+              k_stop_early ( stop_early ), next_chunk_ ( 0 ), first_found_ ( k_chunk_count ),
+              results_ ( k_chunk_count, last ), all_results_ ( stop_early ? 0 : k_chunk_count ) {}
+
+        std::size_t chunk_count () const { return k_chunk_count; }
+
+    //  The leftmost match, or corpus_last
+        corpusIter first_match () const {
+            return first_found_ < k_chunk_count ? results_ [ first_found_ ] : corpus_last;
+            }
+
+        const std::vector<corpusIter> &chunk_matches ( std::size_t chunk ) const { return all_results_ [ chunk ]; }
+
+        void rethrow () const {
+            if ( error_ )
+                boost::rethrow_exception ( error_ );
+            }
+
+    //  The body of each of the worker threads
+        void work () {
+            try {
+                std::size_t chunk = 0;
+                while ( this->next_chunk ( chunk )) {
+                    const corpusIter first = corpus_first + chunk * k_chunk_size;
+                    const corpusIter last  = std::distance ( first, corpus_last ) <= k_chunk_size + k_overlap
+                                                ? corpus_last : first + ( k_chunk_size + k_overlap );
+                    if ( k_stop_early ) {
+                        const corpusIter res = searcher_ ( first, last );
+                        if ( res != last ) {
+                            this->check_pattern_length ( res );
+                            this->found ( chunk, res );
+                            }
+                        }
+                    else {
+                        searcher_.find_all ( first, last, std::back_inserter ( all_results_ [ chunk ] ));
+                        if ( !all_results_ [ chunk ].empty ())
+                            this->check_pattern_length ( all_results_ [ chunk ].front ());
+                        }
+                    }
+                }
+            catch ( ... ) {
+                boost::lock_guard<boost::mutex> lock ( mutex_ );
+                if ( !error_ )
+                    error_ = boost::current_exception ();
+                first_found_ = 0;   // stop everyone else
+                next_chunk_ = k_chunk_count;
+                }
+            }
+
+    private:
+        const Searcher &searcher_;
+        const corpusIter corpus_first, corpus_last;
+        const difference_type k_pattern_length;
+        const difference_type k_overlap;
+        const difference_type k_chunk_size;
+        const std::size_t k_chunk_count;
+        const bool k_stop_early;
+
+        boost::mutex mutex_;
+        std::size_t next_chunk_;            // the next chunk to be searched
+        std::size_t first_found_;           // the first chunk with a match
+        std::vector<corpusIter> results_;   // the first match in each chunk
+        std::vector<std::vector<corpusIter> > all_results_;
+        boost::exception_ptr error_;
+
+        bool next_chunk ( std::size_t &chunk ) {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+        //  Nothing past a match that we've already found can be the leftmost match
+            if ( next_chunk_ >= k_chunk_count || next_chunk_ > first_found_ )
+                return false;
+            chunk = next_chunk_++;
+            return true;
+            }
+
+    //  The pattern matches at 'where'; it should fit in exactly k_pattern_length elements
+        void check_pattern_length ( corpusIter where ) const {
+            if ( std::distance ( where, corpus_last ) < k_pattern_length
+                    || searcher_ ( where, where + k_pattern_length ) != where
+                    || ( k_pattern_length > 1 && searcher_ ( where, where + ( k_pattern_length - 1 )) == where ))
+                BOOST_THROW_EXCEPTION ( parallel_search_error ());
+            }
+
+        void found ( std::size_t chunk, corpusIter where ) {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            results_ [ chunk ] = where;
+            if ( chunk < first_found_ )
+                first_found_ = chunk;
+            }
+        };
+
+    template <typename corpusIter>
+    typename std::iterator_traits<corpusIter>::difference_type
+    parallel_chunk_size ( corpusIter first, corpusIter last, std::size_t pattern_length,
+                          std::size_t thread_count, std::size_t chunk_size ) {
+        typedef typename std::iterator_traits<corpusIter>::difference_type difference_type;
+        if ( chunk_size == 0 ) {
+        //  Several chunks per thread, so that an early match cancels most of the work,
+        //  but big enough that the overlap and the locking don't matter
+            chunk_size = std::distance ( first, last ) / ( 8 * thread_count );
+            chunk_size = (std::max) ( chunk_size, std::size_t ( 64 * 1024 ));
+            }
+        return difference_type ((std::max) ( chunk_size, pattern_length ));
+        }
+
+    inline std::size_t parallel_thread_count ( std::size_t thread_count ) {
+        if ( thread_count == 0 )
+            thread_count = boost::thread::hardware_concurrency ();
+        return thread_count == 0 ? 1 : thread_count;
+        }
+}
+/// \endcond
+
+/*
+    A pool of worker threads for parallel_search and parallel_find_all, which
+    run tasks from a queue. The threads are started by the constructor, and
+    stopped (after the queued tasks have run) by the destructor.
+*/
+    class search_thread_pool : private boost::noncopyable {
+    public:
+        /// \fn search_thread_pool ( std::size_t thread_count )
+        /// \brief Starts the worker threads
+        ///
+        /// \param thread_count The number of threads that work on a search, including
+        ///                     the one that calls it; 0 means one per processor
+        ///
+        explicit search_thread_pool ( std::size_t thread_count = 0 ) : stopping_ ( false ) {
+            thread_count = detail::parallel_thread_count ( thread_count );
+            for ( std::size_t i = 1; i < thread_count; ++i )
+                threads_.create_thread ( boost::bind ( &search_thread_pool::run, this ));
+            }
+
+        ~search_thread_pool () {
+            {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            stopping_ = true;
+            }
+            ready_.notify_all ();
+            threads_.join_all ();
+            }
+
+        /// \fn size () const
+        /// \brief The number of threads that work on a search, including the one that calls it
+        std::size_t size () const { return threads_.size () + 1; }
+
+        /// \fn submit ( const boost::function<void ()> &task )
+        /// \brief Queues 'task' to be run by one of the worker threads; it must not throw
+        void submit ( const boost::function<void ()> &task ) {
+            {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            tasks_.push_back ( task );
+            }
+            ready_.notify_one ();
+            }
+
+    private:
+        boost::thread_group threads_;
+        boost::mutex mutex_;
+        boost::condition_variable ready_;
+        std::deque<boost::function<void ()> > tasks_;
+        bool stopping_;
+
+    //  The body of each of the worker threads
+        void run () {
+            while ( true ) {
+                boost::function<void ()> task;
+                {
+                boost::unique_lock<boost::mutex> lock ( mutex_ );
+                while ( tasks_.empty () && !stopping_ )
+                    ready_.wait ( lock );
+                if ( tasks_.empty ())
+                    return;
+                task.swap ( tasks_.front ());
+                tasks_.pop_front ();
+                }
+                task ();
+                }
+            }
+        };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  Counts the tasks of one search that are still running; they use the caller's
+//  search state, so the caller has to wait for all of them
+    class task_latch {
+    public:
+        explicit task_latch ( std::size_t count ) : count_ ( count ) {}
+
+        void count_down () {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            if ( --count_ == 0 )
+                done_.notify_all ();
+            }
+
+        void wait () {
+            boost::unique_lock<boost::mutex> lock ( mutex_ );
+            while ( count_ != 0 )
+                done_.wait ( lock );
+            }
+
+    private:
+        boost::mutex mutex_;
+        boost::condition_variable done_;
+        std::size_t count_;
+        };
+
+    template <typename State>
+    void parallel_task ( State *state, task_latch *latch ) {
+        state->work ();     // doesn't throw; the errors are kept in the state
+        latch->count_down ();
+        }
+
+    template <typename State>
+    void run_parallel_search ( State &state, search_thread_pool &pool, std::size_t thread_count ) {
+        const std::size_t workers = (std::min) ( (std::min) ( thread_count, pool.size ()), state.chunk_count ());
+        task_latch latch ( workers - 1 );
+        for ( std::size_t i = 1; i < workers; ++i )
+            pool.submit ( boost::bind ( &parallel_task<State>, &state, &latch ));
+        state.work ();      // this thread works too
+        latch.wait ();
+        state.rethrow ();
+        }
+
+//  The pool used when none is passed in; started by the first search that needs it
+    inline search_thread_pool *&shared_search_pool_ptr () {
+        static search_thread_pool *pool = 0;
+        return pool;
+        }
+
+    inline void make_shared_search_pool () {
+        static search_thread_pool pool;
+        shared_search_pool_ptr () = &pool;
+        }
+
+    inline search_thread_pool &shared_search_pool () {
+        static boost::once_flag once = BOOST_ONCE_INIT;
+        boost::call_once ( once, &make_shared_search_pool );
+        return *shared_search_pool_ptr ();
+        }
+}
+/// \endcond
+
+/// \fn parallel_search ( search_thread_pool &pool, const Searcher &searcher,
+///       corpusIter corpus_first, corpusIter corpus_last, std::size_t pattern_length, std::size_t chunk_size )
+/// \brief Searches the corpus for the pattern, using the threads of 'pool'.
+///
+/// \param pool           The threads to search with (and the calling thread)
+/// \param searcher       A searcher object, built from the pattern
+/// \param corpus_first   The start of the data to search (Random Access Iterator)
+/// \param corpus_last    One past the end of the data to search
+/// \param pattern_length The length of the pattern that the searcher was built from
+/// \param chunk_size     The number of positions to search in each chunk; 0 picks a size
+///
+/// Returns an iterator to the leftmost match, or corpus_last.
+    template <typename Searcher, typename corpusIter>
+    corpusIter parallel_search ( search_thread_pool &pool, const Searcher &searcher,
+            corpusIter corpus_first, corpusIter corpus_last, std::size_t pattern_length,
+            std::size_t chunk_size = 0 ) {
+        if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+
+        detail::parallel_search_state<Searcher, corpusIter> state ( searcher, corpus_first, corpus_last,
+                pattern_length,
+                detail::parallel_chunk_size ( corpus_first, corpus_last, pattern_length, pool.size (), chunk_size ),
+                true );
+        if ( state.chunk_count () == 1 )
+            return searcher ( corpus_first, corpus_last );
+
+        detail::run_parallel_search ( state, pool, pool.size ());
+        return state.first_match ();
+        }
+
+/// \fn parallel_search ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last,
+///       std::size_t pattern_length, std::size_t thread_count, std::size_t chunk_size )
+/// \brief Searches the corpus for the pattern, using the threads of the shared pool.
+///
+/// \param searcher       A searcher object, built from the pattern
+/// \param corpus_first   The start of the data to search (Random Access Iterator)
+/// \param corpus_last    One past the end of the data to search
+/// \param pattern_length The length of the pattern that the searcher was built from
+/// \param thread_count   The most threads to use; 0 means one per processor
+/// \param chunk_size     The number of positions to search in each chunk; 0 picks a size
+///
+/// Returns an iterator to the leftmost match, or corpus_last.
+    template <typename Searcher, typename corpusIter>
+    corpusIter parallel_search ( const Searcher &searcher,
+            corpusIter corpus_first, corpusIter corpus_last, std::size_t pattern_length,
+            std::size_t thread_count = 0, std::size_t chunk_size = 0 ) {
+        if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+
+        thread_count = detail::parallel_thread_count ( thread_count );
+        detail::parallel_search_state<Searcher, corpusIter> state ( searcher, corpus_first, corpus_last,
+                pattern_length,
+                detail::parallel_chunk_size ( corpus_first, corpus_last, pattern_length, thread_count, chunk_size ),
+                true );
+        if ( state.chunk_count () == 1 || thread_count == 1 )
+            return searcher ( corpus_first, corpus_last );
+
+        detail::run_parallel_search ( state, detail::shared_search_pool (), thread_count );
+        return state.first_match ();
+        }
+
+/// \fn parallel_find_all ( search_thread_pool &pool, const Searcher &searcher,
+///       corpusIter corpus_first, corpusIter corpus_last, std::size_t pattern_length,
+///       OutputIterator out, std::size_t chunk_size )
+/// \brief Searches the corpus for every occurrence of the pattern, using the threads of 'pool'.
+///
+/// \param pool           The threads to search with (and the calling thread)
+/// \param searcher       A searcher object, built from the pattern
+/// \param corpus_first   The start of the data to search (Random Access Iterator)
+/// \param corpus_last    One past the end of the data to search
+/// \param pattern_length The length of the pattern that the searcher was built from
+/// \param out            An output iterator which receives an iterator to the start of each match
+/// \param chunk_size     The number of positions to search in each chunk; 0 picks a size
+///
+/// All the (possibly overlapping) matches are written to 'out' in order,
+/// after all the threads have finished.
+    template <typename Searcher, typename corpusIter, typename OutputIterator>
+    OutputIterator parallel_find_all ( search_thread_pool &pool, const Searcher &searcher,
+            corpusIter corpus_first, corpusIter corpus_last, std::size_t pattern_length,
+            OutputIterator out, std::size_t chunk_size = 0 ) {
+        if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+
+        detail::parallel_search_state<Searcher, corpusIter> state ( searcher, corpus_first, corpus_last,
+                pattern_length,
+                detail::parallel_chunk_size ( corpus_first, corpus_last, pattern_length, pool.size (), chunk_size ),
+                false );
+        if ( state.chunk_count () == 1 || pattern_length == 0 )
+            return searcher.find_all ( corpus_first, corpus_last, out );
+
+        detail::run_parallel_search ( state, pool, pool.size ());
+        for ( std::size_t i = 0; i < state.chunk_count (); ++i )
+            out = std::copy ( state.chunk_matches ( i ).begin (), state.chunk_matches ( i ).end (), out );
+        return out;
+        }
+
+/// \fn parallel_find_all ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last,
+///       std::size_t pattern_length, OutputIterator out, std::size_t thread_count, std::size_t chunk_size )
+/// \brief Searches the corpus for every occurrence of the pattern, using the threads of the shared pool.
+///
+/// \param searcher       A searcher object, built from the pattern
+/// \param corpus_first   The start of the data to search (Random Access Iterator)
+/// \param corpus_last    One past the end of the data to search
+/// \param pattern_length The length of the pattern that the searcher was built from
+/// \param out            An output iterator which receives an iterator to the start of each match
+/// \param thread_count   The most threads to use; 0 means one per processor
+/// \param chunk_size     The number of positions to search in each chunk; 0 picks a size
+///
+/// All the (possibly overlapping) matches are written to 'out' in order,
+/// after all the threads have finished.
+    template <typename Searcher, typename corpusIter, typename OutputIterator>
+    OutputIterator parallel_find_all ( const Searcher &searcher,
+            corpusIter corpus_first, corpusIter corpus_last, std::size_t pattern_length,
+            OutputIterator out, std::size_t thread_count = 0, std::size_t chunk_size = 0 ) {
+        if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+
+        thread_count = detail::parallel_thread_count ( thread_count );
+        detail::parallel_search_state<Searcher, corpusIter> state ( searcher, corpus_first, corpus_last,
+                pattern_length,
+                detail::parallel_chunk_size ( corpus_first, corpus_last, pattern_length, thread_count, chunk_size ),
+                false );
+        if ( state.chunk_count () == 1 || pattern_length == 0 || thread_count == 1 )
+            return searcher.find_all ( corpus_first, corpus_last, out );
+
+        detail::run_parallel_search ( state, detail::shared_search_pool (), thread_count );
+        for ( std::size_t i = 0; i < state.chunk_count (); ++i )
+            out = std::copy ( state.chunk_matches ( i ).begin (), state.chunk_matches ( i ).end (), out );
+        return out;
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_PARALLEL_SEARCH_HPP
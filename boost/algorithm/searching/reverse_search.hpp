@@ -0,0 +1,201 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_REVERSE_SEARCH_HPP
+#define BOOST_ALGORITHM_REVERSE_SEARCH_HPP
+
+#include <algorithm>    // for std::search
+#include <iterator>     // for std::iterator_traits, std::reverse_iterator
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching for the last occurrence of a pattern (like std::find_end).
+
+    The searchers are built from the reversed pattern, so the skip and suffix
+    tables are the mirror images of the ones used for forward searching, and
+    the corpus is scanned from corpus_last towards corpus_first. The search
+    stops at the last match, so the cost depends on how far that match is from
+    the end of the corpus, rather than the size of the corpus.
+
+    Like std::find_end, the searchers return an iterator to the start of the
+    last match, or corpus_last if there is none (or if the pattern is empty).
+
+    Requirements:
+        * Random access iterators for the pattern
+        * Bidirectional iterators for the corpus; random access iterators
+          are needed to skip (other corpus iterators use std::search)
+        * The two iterator types must "point to" the same underlying type.
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  Search the reversed corpus with 'searcher', and translate the result back
+    template <typename Searcher, typename patIter, typename corpusIter>
+    corpusIter reverse_search ( const Searcher &searcher, patIter /*rev_pat_first*/, patIter /*rev_pat_last*/,
+                typename std::iterator_traits<corpusIter>::difference_type pattern_length,
+                corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) {
+        typedef std::reverse_iterator<corpusIter> rev_corpus;
+        const rev_corpus r = searcher ( rev_corpus ( corpus_last ), rev_corpus ( corpus_first ));
+        if ( r == rev_corpus ( corpus_first ) || pattern_length == 0 )
+            return corpus_last;
+        return ( r + pattern_length ).base ();
+        }
+
+//  Not random access; we can't skip, so use std::search
+    template <typename Searcher, typename patIter, typename corpusIter>
+    corpusIter reverse_search ( const Searcher &/*searcher*/, patIter rev_pat_first, patIter rev_pat_last,
+                typename std::iterator_traits<corpusIter>::difference_type pattern_length,
+                corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) {
+        typedef std::reverse_iterator<corpusIter> rev_corpus;
+        rev_corpus r = std::search ( rev_corpus ( corpus_last ), rev_corpus ( corpus_first ), rev_pat_first, rev_pat_last );
+        if ( r == rev_corpus ( corpus_first ) || pattern_length == 0 )
+            return corpus_last;
+        std::advance ( r, pattern_length );
+        return r.base ();
+        }
+
+    template <typename Iter>
+    struct is_random_access : public boost::integral_constant<bool, boost::is_convertible<
+            typename std::iterator_traits<Iter>::iterator_category,
+            std::random_access_iterator_tag>::value> {};
+}
+/// \endcond
+
+    template <typename patIter, typename traits = detail::BM_traits<std::reverse_iterator<patIter> > >
+    class reverse_boyer_moore {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef std::reverse_iterator<patIter> rev_pat;
+    public:
+        reverse_boyer_moore ( patIter first, patIter last )
+                : pat_first ( last ), pat_last ( first ),
+                  k_pattern_length ( std::distance ( first, last )),
+                  bm_ ( pat_first, pat_last ) {}
+
+        ~reverse_boyer_moore () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the last occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Bidirectional Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            return detail::reverse_search ( bm_, pat_first, pat_last, k_pattern_length,
+                        corpus_first, corpus_last, detail::is_random_access<corpusIter> ());
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        rev_pat pat_first, pat_last;    // the reversed pattern
+        const difference_type k_pattern_length;
+        boyer_moore<rev_pat, traits> bm_;
+/// \endcond
+        };
+
+
+    template <typename patIter, typename traits = detail::BM_traits<std::reverse_iterator<patIter> > >
+    class reverse_boyer_moore_horspool {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef std::reverse_iterator<patIter> rev_pat;
+    public:
+        reverse_boyer_moore_horspool ( patIter first, patIter last )
+                : pat_first ( last ), pat_last ( first ),
+                  k_pattern_length ( std::distance ( first, last )),
+                  bmh_ ( pat_first, pat_last ) {}
+
+        ~reverse_boyer_moore_horspool () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the last occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Bidirectional Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            return detail::reverse_search ( bmh_, pat_first, pat_last, k_pattern_length,
+                        corpus_first, corpus_last, detail::is_random_access<corpusIter> ());
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        rev_pat pat_first, pat_last;    // the reversed pattern
+        const difference_type k_pattern_length;
+        boyer_moore_horspool<rev_pat, traits> bmh_;
+/// \endcond
+        };
+
+
+/// \fn reverse_boyer_moore_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the last occurrence of the pattern.
+///
+/// \param corpus_first The start of the data to search (Bidirectional Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter reverse_boyer_moore_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        reverse_boyer_moore<patIter> bm ( pat_first, pat_last );
+        return bm ( corpus_first, corpus_last );
+        }
+
+/// \fn reverse_boyer_moore_horspool_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the last occurrence of the pattern.
+///
+/// \param corpus_first The start of the data to search (Bidirectional Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter reverse_boyer_moore_horspool_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        reverse_boyer_moore_horspool<patIter> bmh ( pat_first, pat_last );
+        return bmh ( corpus_first, corpus_last );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_REVERSE_SEARCH_HPP
@@ -0,0 +1,120 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_STATS_HPP
+#define BOOST_ALGORITHM_SEARCH_STATS_HPP
+
+#include <cstddef>      // for std::ptrdiff_t
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/is_empty.hpp>
+
+namespace boost { namespace algorithm {
+
+//
+//  Instrumentation policies for the B-M, B-M-H and K-M-P searchers. The searcher
+//  calls the policy at each step of the search:
+//      on_compare ( n )    n elements of the pattern were compared with the corpus
+//                          at one alignment (a match, or a mismatch on the n'th)
+//      on_lookup  ( n )    n entries of the skip tables were read
+//      on_shift   ( n )    the pattern was moved n elements along the corpus
+//
+//  The default policy, no_search_stats, does nothing, and the searchers compile
+//  to the same code that they do without it. counting_search_stats keeps a
+//  search_stats, which the searcher returns from stats ().
+//
+//  The policy is the template parameter 'Stats' of each searcher, and comes
+//  right after the traits (K-M-P has none) and before the allocator:
+//      boyer_moore          <patIter, traits, Stats, Alloc, SuffixTable>
+//      boyer_moore_horspool <patIter, traits, Stats>
+//      knuth_morris_pratt   <patIter,         Stats, Alloc, Table>
+//  folding_traits<patIter> (see bm_traits.hpp) names the default traits:
+//      boyer_moore<const char *, folding_traits<const char *>, counting_search_stats> bm ( first, last );
+//      ... bm ( corpus_first, corpus_last ) ...
+//      std::cout << bm.stats ().comparisons << std::endl;
+//  The counts are for the searches since the last reset_stats ().
+//
+//  The counters are kept in the searcher, and updated by the (const) searches,
+//  so a searcher with counting_search_stats should not be shared between threads.
+//
+
+    struct no_search_stats {
+        void on_compare ( std::ptrdiff_t ) {}
+        void on_lookup  ( std::ptrdiff_t ) {}
+        void on_shift   ( std::ptrdiff_t ) {}
+        };
+
+//  What counting_search_stats counts
+    struct search_stats {
+        search_stats () : comparisons ( 0 ), verifications ( 0 ), max_verification ( 0 ),
+                          lookups ( 0 ), shifts ( 0 ), total_shift ( 0 ), max_shift ( 0 ) {}
+
+        boost::uintmax_t comparisons;       // elements compared
+        boost::uintmax_t verifications;     // alignments at which elements were compared
+        boost::uintmax_t max_verification;  // the most elements compared at one alignment
+        boost::uintmax_t lookups;           // skip table entries read
+        boost::uintmax_t shifts;            // times the pattern was moved
+        boost::uintmax_t total_shift;       // the sum of the shifts
+        boost::uintmax_t max_shift;         // the longest shift
+
+        double average_shift () const {
+            return shifts == 0 ? 0.0 : static_cast<double> ( total_shift ) / shifts;
+            }
+
+        double average_verification () const {
+            return verifications == 0 ? 0.0 : static_cast<double> ( comparisons ) / verifications;
+            }
+        };
+
+    struct counting_search_stats : public search_stats {
+        void on_compare ( std::ptrdiff_t n ) {
+            comparisons += n;
+            ++verifications;
+            if ( static_cast<boost::uintmax_t> ( n ) > max_verification )
+                max_verification = n;
+            }
+
+        void on_lookup ( std::ptrdiff_t n ) { lookups += n; }
+
+        void on_shift ( std::ptrdiff_t n ) {
+            ++shifts;
+            total_shift += n;
+            if ( static_cast<boost::uintmax_t> ( n ) > max_shift )
+                max_shift = n;
+            }
+        };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  The searchers derive from this, to hold their 'Stats'. An empty policy (such as
+//  no_search_stats) is an empty base, and takes no space in the searcher; any other
+//  is a mutable member, since the searches are const.
+    template <typename Stats, bool = boost::is_empty<Stats>::value>
+    class search_stats_holder {
+    protected:
+        Stats &counters () const { return stats_; }
+    private:
+        mutable Stats stats_;
+        };
+
+    template <typename Stats>
+    class search_stats_holder<Stats, true> : private Stats {
+    protected:
+    //  There is no state to change, so handing out a non-const reference is harmless
+        Stats &counters () const {
+            return const_cast<search_stats_holder &> ( *this );
+            }
+        };
+}
+/// \endcond
+
+}} // namespaces
+
+#endif  //  BOOST_ALGORITHM_SEARCH_STATS_HPP
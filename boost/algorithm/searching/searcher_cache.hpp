@@ -0,0 +1,158 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCHER_CACHE_HPP
+#define BOOST_ALGORITHM_SEARCHER_CACHE_HPP
+
+#include <list>
+#include <vector>
+#include <algorithm>    // for std::equal
+#include <iterator>     // for std::distance
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/tr1/tr1/unordered_map>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A cache of searcher objects, keyed by the contents of their patterns.
+
+    Building a searcher (the skip and suffix tables) can cost more than the
+    search itself when the corpus is short. When the same patterns are used
+    over and over, the cache builds each searcher once, and hands out the
+    same one for every later request for that pattern.
+
+    The cache keeps its own copy of each pattern, and builds the searcher
+    from that, so the caller's pattern need not outlive the call. Searchers are
+    handed out as shared_ptr<const Searcher>; a searcher that has been evicted
+    from the cache stays alive until the last of these goes away.
+
+    At most 'capacity' searchers are kept; when the cache is full, the least
+    recently used one is dropped.
+
+    A searcher_cache is not synchronized; use one per thread, or lock around it.
+    The searchers themselves can be shared by several threads.
+
+    Requirements:
+        * Searcher must be constructible from two 'const charT *'
+        * The pattern iterators must "point to" charT
+*/
+
+    template <typename charT, typename Searcher = boyer_moore<const charT *> >
+    class searcher_cache : boost::noncopyable {
+    public:
+        typedef Searcher searcher_type;
+        typedef boost::shared_ptr<const Searcher> searcher_ptr;
+
+        /// \fn searcher_cache ( std::size_t capacity )
+        /// \param capacity     The maximum number of searchers to keep
+        ///
+        explicit searcher_cache ( std::size_t capacity = 64 ) : k_capacity ( capacity ) {
+            BOOST_ASSERT ( capacity > 0 );
+            }
+
+        ~searcher_cache () {}
+
+        /// \fn get ( patIter pat_first, patIter pat_last )
+        /// \brief Returns the searcher for the pattern, building it if it is not in the cache
+        ///
+        /// \param pat_first    The start of the pattern to search for
+        /// \param pat_last     One past the end of the pattern
+        ///
+        template <typename patIter>
+        searcher_ptr get ( patIter pat_first, patIter pat_last ) {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type, charT>::value ));
+
+            const std::size_t h = boost::hash_range ( pat_first, pat_last );
+            const std::size_t len = std::distance ( pat_first, pat_last );
+
+            std::pair<typename index_type::iterator, typename index_type::iterator> r = index_.equal_range ( h );
+            for ( ; r.first != r.second; ++r.first ) {
+                const entry &e = **r.first->second;
+                if ( e.pattern.size () == len && std::equal ( e.pattern.begin (), e.pattern.end (), pat_first )) {
+                //  Move it to the front of the list
+                    lru_.splice ( lru_.begin (), lru_, r.first->second );
+                    return searcher_ptr ( lru_.front (), &lru_.front ()->searcher );
+                    }
+                }
+
+        //  Not found; build a new one
+            lru_.push_front ( boost::make_shared<entry> ( pat_first, pat_last, h ));
+            index_.insert ( std::make_pair ( h, lru_.begin ()));
+            if ( lru_.size () > k_capacity )
+                this->evict ();
+            return searcher_ptr ( lru_.front (), &lru_.front ()->searcher );
+            }
+
+        /// \fn search ( corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last )
+        /// \brief Searches the corpus for the pattern, using the cached searcher for the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param pat_first    The start of the pattern to search for
+        /// \param pat_last     One past the end of the pattern
+        ///
+        template <typename corpusIter, typename patIter>
+        corpusIter search ( corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last ) {
+            return (*this->get ( pat_first, pat_last )) ( corpus_first, corpus_last );
+            }
+
+        std::size_t size ()     const { return lru_.size (); }
+        std::size_t capacity () const { return k_capacity; }
+        void clear () { index_.clear (); lru_.clear (); }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        struct entry {
+            template <typename patIter>
+            entry ( patIter pat_first, patIter pat_last, std::size_t h )
+                : hash ( h ), pattern ( pat_first, pat_last ),
+                  searcher ( pattern.empty () ? NULL : &pattern [ 0 ],
+                             pattern.empty () ? NULL : &pattern [ 0 ] + pattern.size ()) {}
+
+            const std::size_t hash;             // the key in the index
+            const std::vector<charT> pattern;   // must be constructed before the searcher
+            const Searcher searcher;
+            };
+
+        typedef std::list<boost::shared_ptr<entry> > lru_type;          // most recently used first
+        typedef std::tr1::unordered_multimap<std::size_t, typename lru_type::iterator> index_type;
+
+        const std::size_t k_capacity;
+        lru_type lru_;
+        index_type index_;
+
+    //  Drop the least recently used entry; it is found in the index by the hash
+    //  that it was inserted with.
+        void evict () {
+            const typename lru_type::iterator victim = --lru_.end ();
+            std::pair<typename index_type::iterator, typename index_type::iterator> r =
+                index_.equal_range ( (*victim)->hash );
+            for ( ; r.first != r.second; ++r.first )
+                if ( r.first->second == victim )
+                    break;
+            BOOST_ASSERT ( r.first != r.second );
+            index_.erase ( r.first );
+            lru_.erase ( victim );
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCHER_CACHE_HPP
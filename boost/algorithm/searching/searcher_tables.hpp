@@ -0,0 +1,355 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  searcher_tables.hpp
+/// \brief Saving the tables of the byte searchers to a binary blob, and searching
+///     with them straight out of (mapped) memory, without building them again.
+/// \author Marshall Clow
+
+#ifndef BOOST_ALGORITHM_SEARCHER_TABLES_HPP
+#define BOOST_ALGORITHM_SEARCHER_TABLES_HPP
+
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memcpy, std::memcmp
+#include <iterator>     // for std::iterator_traits
+#include <memory>       // for std::allocator
+#include <ostream>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Building the tables for a long pattern takes time (for boyer_moore, several
+    passes over the pattern, and some temporary vectors). When the same patterns
+    are used over and over, by many processes, the tables can be built once, and
+    saved with write_searcher_tables. The blob holds the pattern, the boyer_moore
+    skip and suffix tables, the boyer_moore_horspool skip table and the
+    knuth_morris_pratt table.
+
+    A searcher_tables object checks a blob (in memory, or in a file mapped with
+    mapped_corpus), and the mapped_boyer_moore, mapped_boyer_moore_horspool and
+    mapped_knuth_morris_pratt searchers (and their basic_mapped_* templates, for
+    a corpus of signed or unsigned char) use the tables in it where they are,
+    without copying them; so processes that map the same file share the pages.
+    The blob must stay where it is for as long as the searchers are used.
+
+    The layout (version 1) is, in the byte order of the machine that wrote it:
+        char    magic [ 8 ]         "BALGSRCH"
+        uint32  version             1
+        uint32  byte order mark     0x01020304
+        uint64  pattern length (m)
+        uint64  total size of the blob
+        uint64  offsets of the sections, in this order:
+            int32   boyer_moore skip table              [ 256 ]
+            int32   boyer_moore_horspool skip table     [ 256 ]
+            int32   boyer_moore suffix table            [ m + 1 ]
+            int32   knuth_morris_pratt table            [ m + 1 ]
+            uint8   the pattern                         [ m ]
+
+    Only byte patterns are supported, and only without folding. A blob that is
+    damaged, from a different version, or written on a machine with a different
+    byte order is rejected with searcher_tables_error. Besides the header, every
+    entry of the tables is checked (in O(256 + m)) to be one that the searchers
+    can use safely.
+
+    Requirements:
+        * The elements of the pattern and the corpus are bytes (char, signed char or unsigned char)
+        * Random access iterators for the corpus
+*/
+
+/*!
+    \struct searcher_tables_error
+    \brief  Thrown when a blob of searcher tables cannot be written or used.
+*/
+struct searcher_tables_error: virtual boost::exception, virtual std::exception {};
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    struct searcher_tables_layout {
+        BOOST_STATIC_CONSTANT ( std::size_t, k_header_size = 8 + 4 + 4 + 8 + 8 + 5 * 8 );
+        BOOST_STATIC_CONSTANT ( std::size_t, k_sections = 5 );
+        BOOST_STATIC_CONSTANT ( boost::uint32_t, k_version = 1 );
+        BOOST_STATIC_CONSTANT ( boost::uint32_t, k_byte_order = 0x01020304 );
+        static const char *magic () { return "BALGSRCH"; }
+
+        explicit searcher_tables_layout ( boost::uint64_t m ) {
+            offsets [ 0 ] = k_header_size;                                  // bm skip
+            offsets [ 1 ] = offsets [ 0 ] + 256 * sizeof ( boost::int32_t );  // bmh skip
+            offsets [ 2 ] = offsets [ 1 ] + 256 * sizeof ( boost::int32_t );  // bm suffix
+            offsets [ 3 ] = offsets [ 2 ] + ( m + 1 ) * sizeof ( boost::int32_t );  // kmp
+            offsets [ 4 ] = offsets [ 3 ] + ( m + 1 ) * sizeof ( boost::int32_t );  // pattern
+            total_size    = offsets [ 4 ] + m;
+            }
+
+        boost::uint64_t offsets [ k_sections ];
+        boost::uint64_t total_size;
+        };
+
+    template <typename Iter>
+    struct is_byte_iterator {
+        typedef typename std::iterator_traits<Iter>::value_type value_type;
+        BOOST_STATIC_CONSTANT ( bool, value =
+            boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 );
+        };
+
+    inline unsigned char to_byte ( unsigned char c ) { return c; }
+    inline unsigned char to_byte ( char c )          { return static_cast<unsigned char> ( c ); }
+    inline unsigned char to_byte ( signed char c )   { return static_cast<unsigned char> ( c ); }
+
+    template <typename charT>
+    const charT *mapped_pattern ( const unsigned char *p ) {
+        return reinterpret_cast<const charT *> ( p );
+        }
+
+//  Views of the tables in a blob, which the searchers use in place of their own
+    class mapped_table {
+    public:
+        explicit mapped_table ( const boost::int32_t *table ) : table_ ( table ) {}
+        std::ptrdiff_t operator [] ( std::ptrdiff_t idx ) const { return table_ [ idx ]; }
+    private:
+        const boost::int32_t *table_;
+        };
+
+    template <typename charT>
+    class mapped_skip_table {
+    public:
+        explicit mapped_skip_table ( const boost::int32_t *table ) : table_ ( table ) {}
+        std::ptrdiff_t operator [] ( charT key ) const { return table_ [ to_byte ( key ) ]; }
+    private:
+        const boost::int32_t *table_;
+        };
+
+    template <typename charT>
+    struct mapped_traits {
+        typedef std::ptrdiff_t value_type;
+        typedef charT key_type;
+        typedef mapped_skip_table<charT> skip_table_t;
+        };
+}
+/// \endcond
+
+/*
+    Reads the tables out of the searchers; it is a friend of each of them.
+*/
+    class searcher_tables_writer {
+    public:
+        template <typename patIter>
+        static void write ( patIter first, patIter last, std::ostream &out ) {
+            BOOST_STATIC_ASSERT (( detail::is_byte_iterator<patIter>::value ));
+            typedef const unsigned char *byte_iter;
+
+            std::vector<unsigned char> pattern;
+            for ( ; first != last; ++first )
+                pattern.push_back ( detail::to_byte ( *first ));
+            if ( pattern.size () > 0x7FFFFFFFUL )
+                BOOST_THROW_EXCEPTION ( searcher_tables_error ());
+
+            const byte_iter pat_first = pattern.empty () ? NULL : &pattern [ 0 ];
+            const byte_iter pat_last  = pat_first + pattern.size ();
+            const boyer_moore<byte_iter>          bm  ( pat_first, pat_last );
+            const boyer_moore_horspool<byte_iter> bmh ( pat_first, pat_last );
+            const knuth_morris_pratt<byte_iter>   kmp ( pat_first, pat_last );
+
+            const detail::searcher_tables_layout layout ( pattern.size ());
+            out.write ( detail::searcher_tables_layout::magic (), 8 );
+            put<boost::uint32_t> ( out, detail::searcher_tables_layout::k_version );
+            put<boost::uint32_t> ( out, detail::searcher_tables_layout::k_byte_order );
+            put<boost::uint64_t> ( out, pattern.size ());
+            put<boost::uint64_t> ( out, layout.total_size );
+            for ( std::size_t i = 0; i < detail::searcher_tables_layout::k_sections; ++i )
+                put<boost::uint64_t> ( out, layout.offsets [ i ] );
+
+            for ( unsigned c = 0; c < 256; ++c )
+                put<boost::int32_t> ( out, static_cast<boost::int32_t> ( bm.skip_ [ static_cast<unsigned char> ( c ) ] ));
+            for ( unsigned c = 0; c < 256; ++c )
+                put<boost::int32_t> ( out, static_cast<boost::int32_t> ( bmh.skip_ [ static_cast<unsigned char> ( c ) ] ));
+            for ( std::size_t i = 0; i < bm.suffix_.size (); ++i )
+                put<boost::int32_t> ( out, static_cast<boost::int32_t> ( bm.suffix_ [ i ] ));
+            for ( std::size_t i = 0; i < kmp.skip_.size (); ++i )
+                put<boost::int32_t> ( out, static_cast<boost::int32_t> ( kmp.skip_ [ i ] ));
+            if ( !pattern.empty ())
+                out.write ( reinterpret_cast<const char *> ( pat_first ), pattern.size ());
+            if ( !out )
+                BOOST_THROW_EXCEPTION ( searcher_tables_error ());
+            }
+
+    private:
+        template <typename T>
+        static void put ( std::ostream &out, T val ) {
+            out.write ( reinterpret_cast<const char *> ( &val ), sizeof ( T ));
+            }
+        };
+
+/// \fn write_searcher_tables ( patIter first, patIter last, std::ostream &out )
+/// \brief Builds the tables for the pattern, and writes them (and the pattern) to 'out'
+///
+/// \param first    The start of the pattern (bytes)
+/// \param last     One past the end of the pattern
+/// \param out      Where to write the blob; it should be opened in binary mode
+///
+    template <typename patIter>
+    void write_searcher_tables ( patIter first, patIter last, std::ostream &out ) {
+        searcher_tables_writer::write ( first, last, out );
+        }
+
+    template <typename Range>
+    void write_searcher_tables ( const Range &pattern, std::ostream &out ) {
+        searcher_tables_writer::write ( boost::begin ( pattern ), boost::end ( pattern ), out );
+        }
+
+
+/*
+    A view of a blob written by write_searcher_tables. The blob is checked when the
+    view is made; nothing is copied.
+*/
+    class searcher_tables {
+    public:
+        /// \fn searcher_tables ( const void *data, std::size_t size )
+        /// \param data     The start of the blob; it must be aligned for boost::int32_t
+        /// \param size     The size of the blob, in bytes
+        ///
+        searcher_tables ( const void *data, std::size_t size ) {
+            const unsigned char *bytes = static_cast<const unsigned char *> ( data );
+            if ( size < detail::searcher_tables_layout::k_header_size
+                    || reinterpret_cast<std::size_t> ( data ) % sizeof ( boost::int32_t ) != 0
+                    || std::memcmp ( bytes, detail::searcher_tables_layout::magic (), 8 ) != 0
+                    || get<boost::uint32_t> ( bytes +  8 ) != detail::searcher_tables_layout::k_version
+                    || get<boost::uint32_t> ( bytes + 12 ) != detail::searcher_tables_layout::k_byte_order )
+                BOOST_THROW_EXCEPTION ( searcher_tables_error ());
+
+            const boost::uint64_t m = get<boost::uint64_t> ( bytes + 16 );
+            if ( m > 0x7FFFFFFFUL )
+                BOOST_THROW_EXCEPTION ( searcher_tables_error ());
+            const detail::searcher_tables_layout layout ( m );
+            bool ok = get<boost::uint64_t> ( bytes + 24 ) == layout.total_size && layout.total_size <= size;
+            for ( std::size_t i = 0; ok && i < detail::searcher_tables_layout::k_sections; ++i )
+                ok = get<boost::uint64_t> ( bytes + 32 + 8 * i ) == layout.offsets [ i ];
+            if ( !ok )
+                BOOST_THROW_EXCEPTION ( searcher_tables_error ());
+
+            pattern_length_ = static_cast<std::size_t> ( m );
+            bm_skip_   = reinterpret_cast<const boost::int32_t *> ( bytes + layout.offsets [ 0 ] );
+            bmh_skip_  = reinterpret_cast<const boost::int32_t *> ( bytes + layout.offsets [ 1 ] );
+            bm_suffix_ = reinterpret_cast<const boost::int32_t *> ( bytes + layout.offsets [ 2 ] );
+            kmp_skip_  = reinterpret_cast<const boost::int32_t *> ( bytes + layout.offsets [ 3 ] );
+            pattern_   = bytes + layout.offsets [ 4 ];
+
+            if ( !tables_are_valid ())
+                BOOST_THROW_EXCEPTION ( searcher_tables_error ());
+            }
+
+        std::size_t             pattern_length () const { return pattern_length_; }
+        const unsigned char *   pattern_begin  () const { return pattern_; }
+        const unsigned char *   pattern_end    () const { return pattern_ + pattern_length_; }
+
+        const boost::int32_t *  bm_skip   () const { return bm_skip_; }     // [ 256 ]
+        const boost::int32_t *  bmh_skip  () const { return bmh_skip_; }    // [ 256 ]
+        const boost::int32_t *  bm_suffix () const { return bm_suffix_; }   // [ m + 1 ]
+        const boost::int32_t *  kmp_skip  () const { return kmp_skip_; }    // [ m + 1 ]
+
+    private:
+/// \cond DOXYGEN_HIDE
+        std::size_t pattern_length_;
+        const unsigned char *pattern_;
+        const boost::int32_t *bm_skip_, *bmh_skip_, *bm_suffix_, *kmp_skip_;
+
+    //  The searchers index the corpus and the tables with these values, and rely on
+    //  each shift moving forward; so check every entry, not just the header.
+        bool tables_are_valid () const {
+            const boost::int32_t m = static_cast<boost::int32_t> ( pattern_length_ );
+            if ( m == 0 )   // the tables of an empty pattern are never used
+                return true;
+            for ( std::size_t i = 0; i < 256; ++i )
+                if ( bm_skip_ [ i ] < -1 || bm_skip_ [ i ] >= m
+                        || bmh_skip_ [ i ] < 1 || bmh_skip_ [ i ] > m )
+                    return false;
+            if ( kmp_skip_ [ 0 ] != -1 )
+                return false;
+            for ( boost::int32_t i = 0; i <= m; ++i )
+                if ( bm_suffix_ [ i ] < 1 || bm_suffix_ [ i ] > m
+                        || ( i > 0 && ( kmp_skip_ [ i ] < -1 || kmp_skip_ [ i ] >= i )))
+                    return false;
+            return true;
+            }
+
+        template <typename T>
+        static T get ( const unsigned char *p ) {
+            T val;
+            std::memcpy ( &val, p, sizeof ( T ));
+            return val;
+            }
+/// \endcond
+        };
+
+
+/*
+    The searchers. They are boyer_moore, boyer_moore_horspool and knuth_morris_pratt
+    searchers, for a corpus of 'charT' (char, signed char or unsigned char), which
+    look up the tables in the blob instead of tables of their own; so they find the
+    same matches, in the same way.
+*/
+    template <typename charT, typename Stats = no_search_stats>
+    class basic_mapped_boyer_moore
+            : public boyer_moore<const charT *, detail::mapped_traits<charT>,
+                        Stats, std::allocator<std::ptrdiff_t>, detail::mapped_table> {
+        BOOST_STATIC_ASSERT (( detail::is_byte_iterator<const charT *>::value ));
+        typedef boyer_moore<const charT *, detail::mapped_traits<charT>,
+                        Stats, std::allocator<std::ptrdiff_t>, detail::mapped_table> base_type;
+    public:
+        explicit basic_mapped_boyer_moore ( const searcher_tables &tables )
+                : base_type ( detail::mapped_pattern<charT> ( tables.pattern_begin ()),
+                              detail::mapped_pattern<charT> ( tables.pattern_end ()),
+                              detail::mapped_skip_table<charT> ( tables.bm_skip ()),
+                              detail::mapped_table ( tables.bm_suffix ())) {}
+        };
+
+    template <typename charT, typename Stats = no_search_stats>
+    class basic_mapped_boyer_moore_horspool
+            : public boyer_moore_horspool<const charT *, detail::mapped_traits<charT>, Stats> {
+        BOOST_STATIC_ASSERT (( detail::is_byte_iterator<const charT *>::value ));
+        typedef boyer_moore_horspool<const charT *, detail::mapped_traits<charT>, Stats> base_type;
+    public:
+        explicit basic_mapped_boyer_moore_horspool ( const searcher_tables &tables )
+                : base_type ( detail::mapped_pattern<charT> ( tables.pattern_begin ()),
+                              detail::mapped_pattern<charT> ( tables.pattern_end ()),
+                              detail::mapped_skip_table<charT> ( tables.bmh_skip ())) {}
+        };
+
+    template <typename charT, typename Stats = no_search_stats>
+    class basic_mapped_knuth_morris_pratt
+            : public knuth_morris_pratt<const charT *, Stats, std::allocator<std::ptrdiff_t>, detail::mapped_table> {
+        BOOST_STATIC_ASSERT (( detail::is_byte_iterator<const charT *>::value ));
+        typedef knuth_morris_pratt<const charT *, Stats, std::allocator<std::ptrdiff_t>, detail::mapped_table> base_type;
+    public:
+        explicit basic_mapped_knuth_morris_pratt ( const searcher_tables &tables )
+                : base_type ( detail::mapped_pattern<charT> ( tables.pattern_begin ()),
+                              detail::mapped_pattern<charT> ( tables.pattern_end ()),
+                              detail::mapped_table ( tables.kmp_skip ())) {}
+        };
+
+    typedef basic_mapped_boyer_moore<char>              mapped_boyer_moore;
+    typedef basic_mapped_boyer_moore_horspool<char>     mapped_boyer_moore_horspool;
+    typedef basic_mapped_knuth_morris_pratt<char>       mapped_knuth_morris_pratt;
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCHER_TABLES_HPP
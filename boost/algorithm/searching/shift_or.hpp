@@ -0,0 +1,289 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SHIFT_OR_SEARCH_HPP
+#define BOOST_ALGORITHM_SHIFT_OR_SEARCH_HPP
+
+#include <algorithm>    // for std::equal, std::min
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A templated version of the Shift-Or (bit-parallel) searching algorithm.
+
+    The state of the search - which prefixes of the pattern match the corpus
+    ending at the current position - is kept in the bits of a single 64-bit word.
+    Each element of the corpus costs one table lookup, a shift and an 'or',
+    with no data-dependent branches, so the time per element is the same
+    whatever the pattern and the corpus are. This makes it a good choice for
+    short patterns (up to 64 elements), where the skips that B-M and B-M-H
+    can make are small.
+
+    Longer patterns are searched for by their first 64 elements; each match of
+    those is then checked against the rest of the pattern.
+
+    The masks are kept in a 256 entry table for byte patterns; wider element
+    types use a hash table.
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types must "point to" the same underlying type.
+        * Hashable type (for elements wider than a byte)
+
+    http://www-igm.univ-mlv.fr/~lecroq/string/node6.html
+    R. Baeza-Yates and G. Gonnet, "A new approach to text searching", CACM 35 (1992)
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  The mask table: bit i of mask [c] is clear if pattern [i] == c
+    template <typename patIter>
+    struct SO_traits {
+        typedef boost::uint64_t word_type;
+        typedef typename std::iterator_traits<patIter>::value_type key_type;
+        BOOST_STATIC_CONSTANT ( bool, is_int = boost::is_integral<key_type>::value );
+        typedef typename boost::mpl::if_c<is_int && ( sizeof(key_type) == 1 ),
+                    skip_table<key_type, word_type, true>,
+                    typename boost::mpl::if_c<is_int,
+                        compact_skip_table<key_type, word_type>,
+                        skip_table<key_type, word_type, false>
+                    >::type
+                >::type mask_table_t;
+        };
+}
+/// \endcond
+
+    template <typename patIter, typename traits = detail::SO_traits<patIter> >
+    class shift_or {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename traits::word_type word_type;
+    public:
+        shift_or ( patIter first, patIter last )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  k_filter_length ( (std::min) ( k_pattern_length, difference_type ( k_word_bits ))),
+                  k_match_bit ( k_filter_length == 0 ? 0 : word_type ( 1 ) << ( k_filter_length - 1 )),
+                  masks_ ( k_filter_length, ~word_type ( 0 )) {
+        //  Build the mask table
+            for ( difference_type i = 0; i < k_filter_length; ++i )
+                masks_.insert ( first [ i ], masks_ [ first [ i ]] & ~( word_type ( 1 ) << i ));
+#ifdef BOOST_ALGORITHM_SHIFT_OR_DEBUG
+            masks_.PrintSkipTable ();
+#endif
+            }
+
+        ~shift_or () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+            corpusIter curPos = corpus_first;
+            word_type state = ~word_type ( 0 );
+            return this->find_next ( curPos, corpus_last, state );
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern that was passed into the constructor
+        ///
+        /// The corpus is scanned once; the state is carried from one match to the next.
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) {            // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return out;
+
+            corpusIter curPos = corpus_first;
+            word_type state = ~word_type ( 0 );
+            corpusIter match;
+            while (( match = this->find_next ( curPos, corpus_last, state )) != corpus_last ) {
+                *out++ = match;
+            //  Start over after the match
+                if ( !overlapping ) {
+                    if ( std::distance ( match, corpus_last ) - k_pattern_length < k_pattern_length )
+                        break;
+                    curPos = match + k_pattern_length;
+                    state = ~word_type ( 0 );
+                    }
+                }
+            return out;
+            }
+
+        /// \class cursor
+        /// \brief Finds the matches in a corpus one at a time (see matches () in match_generator.hpp)
+        ///
+        /// Like find_all, the state word is carried from one match to the next,
+        /// so each element of the corpus is fed to it once.
+        template <typename corpusIter>
+        class cursor {
+        public:
+            cursor ( const shift_or &searcher, corpusIter corpus_first, corpusIter corpus_last )
+                    : searcher_ ( searcher ), curPos_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                      state_ ( ~word_type ( 0 )) {
+                BOOST_STATIC_ASSERT (( boost::is_same<
+                    typename std::iterator_traits<patIter>::value_type,
+                    typename std::iterator_traits<corpusIter>::value_type>::value ));
+                }
+
+            /// \fn next ()
+            /// \brief Returns the next match, or corpus_last when there are no more
+            corpusIter next () {
+                if ( searcher_.pat_first == searcher_.pat_last )    // empty pattern matches everywhere
+                    return curPos_ == corpus_last_ ? corpus_last_ : curPos_++;
+                return searcher_.find_next ( curPos_, corpus_last_, state_ );
+                }
+
+        private:
+            const shift_or &searcher_;
+            corpusIter curPos_;
+            const corpusIter corpus_last_;
+            word_type state_;
+            };
+
+    private:
+/// \cond DOXYGEN_HIDE
+        BOOST_STATIC_CONSTANT ( int, k_word_bits = sizeof ( word_type ) * CHAR_BIT );
+
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        const difference_type k_filter_length;  // the part of the pattern in the state word
+        const word_type k_match_bit;
+        typename traits::mask_table_t masks_;
+
+        /// \fn find_next ( corpusIter &curPos, corpusIter corpus_last, word_type &state )
+        /// \brief Feeds the corpus from 'curPos' into 'state', until the pattern matches
+        ///
+        /// Returns the start of the match (with 'curPos' just past the end of the
+        /// first k_filter_length elements of it), or corpus_last.
+        template <typename corpusIter>
+        corpusIter find_next ( corpusIter &curPos, corpusIter corpus_last, word_type &state ) const {
+            while ( curPos != corpus_last ) {
+                state = ( state << 1 ) | masks_ [ *curPos++ ];
+                if (( state & k_match_bit ) == 0 ) {
+                    const corpusIter start = curPos - k_filter_length;
+                //  For long patterns, check the rest of the pattern
+                    if ( k_filter_length == k_pattern_length )
+                        return start;
+                    if ( std::distance ( start, corpus_last ) < k_pattern_length )
+                        break;
+                    if ( std::equal ( pat_first + k_filter_length, pat_last, curPos ))
+                        return start;
+                    }
+                }
+            return corpus_last;
+            }
+/// \endcond
+        };
+
+
+/// \fn shift_or_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter shift_or_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        shift_or<patIter> so ( pat_first, pat_last );
+        return so ( corpus_first, corpus_last );
+        }
+
+/// \fn shift_or_find_all ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last, OutputIterator out, bool overlapping )
+/// \brief Searches the corpus for every occurrence of the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param out          An output iterator which receives an iterator to the start of each match
+/// \param overlapping  If false, matches that overlap an earlier match are not reported
+///
+    template <typename patIter, typename corpusIter, typename OutputIterator>
+    OutputIterator shift_or_find_all (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last,
+            OutputIterator out, bool overlapping = true ) {
+        shift_or<patIter> so ( pat_first, pat_last );
+        return so.find_all ( corpus_first, corpus_last, out, overlapping );
+        }
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::shift_or<typename boost::range_iterator<const Range>::type>
+    make_shift_or ( const Range &r ) {
+        return boost::algorithm::shift_or
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::shift_or<typename boost::range_iterator<Range>::type>
+    make_shift_or ( Range &r ) {
+        return boost::algorithm::shift_or
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SHIFT_OR_SEARCH_HPP
@@ -0,0 +1,299 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_STATIC_BOYER_MOORE_SEARCH_HPP
+#define BOOST_ALGORITHM_STATIC_BOYER_MOORE_SEARCH_HPP
+
+#include <boost/config.hpp>
+
+//  The tables are built by the compiler, which needs C++14 constexpr
+#if !defined(BOOST_NO_CXX14_CONSTEXPR) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+#include <cstddef>      // for std::size_t, std::ptrdiff_t
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/conditional.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    The boyer-moore search, for a pattern that is known at compile time.
+
+    The pattern is given as template arguments:
+        static_boyer_moore<char, 'G', 'E', 'T', ' '> get_searcher;
+
+    The "bad character" and "good suffix" tables are computed by the compiler,
+    and stored as constant static data; constructing the searcher does nothing,
+    and it never allocates memory. For short patterns, the comparison of the
+    pattern against the corpus is fully unrolled.
+
+    The interface is the same as the boyer_moore_horspool object, except that the
+    constructor takes no arguments.
+
+    Requirements:
+        * Random access iterators for the corpus, which "point to" charT
+        * charT must be an integral type
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  Byte sized keys index a table directly; others are found by binary search in
+//  a sorted list of the (distinct) elements of the pattern.
+    template <typename charT, std::size_t N>
+    struct static_bm_tables {
+        BOOST_STATIC_CONSTANT ( bool, is_byte = sizeof ( charT ) == 1 );
+        BOOST_STATIC_CONSTANT ( std::size_t, skip_size = is_byte ? 256 : 1 );
+        BOOST_STATIC_CONSTANT ( std::size_t, key_count = is_byte || N == 0 ? 1 : N );
+        typedef typename boost::make_unsigned<charT>::type unsigned_key_type;
+
+        std::ptrdiff_t skip   [ skip_size ];    // the last position of each byte in the pattern, or -1
+        charT          keys   [ key_count ];    // (wide keys) the distinct elements of the pattern, sorted
+        std::ptrdiff_t last   [ key_count ];    // (wide keys) the last position of keys [i]
+        std::size_t    nkeys;
+        std::ptrdiff_t suffix [ N + 1 ];
+
+        constexpr static_bm_tables ( const charT *pat ) : skip (), keys (), last (), nkeys ( 0 ), suffix () {
+            for ( std::size_t i = 0; i < skip_size; ++i )
+                skip [ i ] = -1;
+            if ( N == 0 ) return;
+
+            if ( is_byte )
+                for ( std::size_t i = 0; i < N; ++i )
+                    skip [ static_cast<unsigned_key_type> ( pat [ i ] ) ] = i;
+            else
+                for ( std::size_t i = 0; i < N; ++i ) {
+                //  Insertion sort; a repeated key just updates its position
+                    std::size_t j = 0;
+                    while ( j < nkeys && keys [ j ] < pat [ i ] )
+                        ++j;
+                    if ( j == nkeys || pat [ i ] < keys [ j ] ) {
+                        for ( std::size_t k = nkeys; k > j; --k ) {
+                            keys [ k ] = keys [ k - 1 ];
+                            last [ k ] = last [ k - 1 ];
+                            }
+                        keys [ j ] = pat [ i ];
+                        ++nkeys;
+                        }
+                    last [ j ] = i;
+                    }
+
+        //  The good suffix table; the same computation as boyer_moore::build_suffix_table
+            std::size_t prefix [ N ? N : 1 ] = {}, prefix_reversed [ N ? N : 1 ] = {};
+            std::size_t k = 0;
+            for ( std::size_t i = 1; i < N; ++i ) {
+                while ( k > 0 && pat [ k ] != pat [ i ] )
+                    k = prefix [ k - 1 ];
+                if ( pat [ k ] == pat [ i ] )
+                    k++;
+                prefix [ i ] = k;
+                }
+            k = 0;
+            for ( std::size_t i = 1; i < N; ++i ) {
+                while ( k > 0 && pat [ N - 1 - k ] != pat [ N - 1 - i ] )
+                    k = prefix_reversed [ k - 1 ];
+                if ( pat [ N - 1 - k ] == pat [ N - 1 - i ] )
+                    k++;
+                prefix_reversed [ i ] = k;
+                }
+
+            for ( std::size_t i = 0; i <= N; i++ )
+                suffix [ i ] = N - prefix [ N - 1 ];
+            for ( std::size_t i = 0; i < N; i++ ) {
+                const std::size_t    j = N - prefix_reversed [ i ];
+                const std::ptrdiff_t d = i - prefix_reversed [ i ] + 1;
+                if ( suffix [ j ] > d )
+                    suffix [ j ] = d;
+                }
+            }
+
+        constexpr std::ptrdiff_t bad_char ( charT c ) const {
+            if ( is_byte )
+                return skip [ static_cast<unsigned_key_type> ( c ) ];
+            std::size_t lo = 0, hi = nkeys;
+            while ( lo < hi ) {
+                const std::size_t mid = lo + ( hi - lo ) / 2;
+                if ( keys [ mid ] < c )
+                    lo = mid + 1;
+                else
+                    hi = mid;
+                }
+            return lo < nkeys && keys [ lo ] == c ? last [ lo ] : -1;
+            }
+        };
+}
+/// \endcond
+
+    template <typename charT, charT... Pattern>
+    class static_boyer_moore {
+        BOOST_STATIC_ASSERT ( boost::is_integral<charT>::value );
+        typedef std::ptrdiff_t difference_type;
+        typedef detail::static_bm_tables<charT, sizeof... ( Pattern )> tables_type;
+
+    //  Patterns up to this long are compared without a loop
+        BOOST_STATIC_CONSTANT ( std::size_t, k_unroll_limit = 32 );
+
+    public:
+        BOOST_STATIC_CONSTANT ( std::size_t, pattern_length = sizeof... ( Pattern ));
+
+        /// The pattern (with an extra element at the end, so that it is never empty)
+        static constexpr charT pattern [ pattern_length + 1 ] = { Pattern..., charT () };
+
+        /// The skip and suffix tables
+        static constexpr tables_type tables = tables_type ( pattern );
+
+        constexpr static_boyer_moore () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<charT,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if ( pattern_length == 0 ) return corpus_first;         // empty pattern matches at start
+
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( std::distance ( corpus_first, corpus_last ) < difference_type ( pattern_length ))
+                return corpus_last;
+
+        //  Do the search
+            return this->do_search ( corpus_first, corpus_last );
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<charT,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if ( pattern_length == 0 ) {                    // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( std::distance ( corpus_first, corpus_last ) < difference_type ( pattern_length ))
+                return out;
+
+        //  After a match, either shift by the period of the pattern, or past the match
+            const difference_type k_match_shift = overlapping ? tables.suffix [ 0 ] : pattern_length;
+            corpusIter curPos = corpus_first;
+            while (( curPos = this->do_search ( curPos, corpus_last )) != corpus_last ) {
+                *out++ = curPos;
+                curPos += k_match_shift;
+                }
+            return out;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+    //  Compare the pattern against the corpus, from the end. Returns 0 if they match,
+    //  or j, where pattern [ j - 1 ] is the (last) mismatch.
+        template <typename corpusIter, std::size_t J>
+        static difference_type mismatch ( corpusIter curPos, boost::integral_constant<std::size_t, J> ) {
+            return pattern [ J - 1 ] == curPos [ J - 1 ]
+                ? mismatch ( curPos, boost::integral_constant<std::size_t, J - 1> ())
+                : difference_type ( J );
+            }
+
+        template <typename corpusIter>
+        static difference_type mismatch ( corpusIter, boost::integral_constant<std::size_t, 0> ) {
+            return 0;
+            }
+
+        template <typename corpusIter>
+        static difference_type mismatch ( corpusIter curPos, boost::false_type ) {
+            difference_type j = pattern_length;
+            while ( j > 0 && pattern [ j - 1 ] == curPos [ j - 1 ] )
+                --j;
+            return j;
+            }
+
+        template <typename corpusIter>
+        static difference_type mismatch ( corpusIter curPos ) {
+            typedef typename boost::conditional<( pattern_length > k_unroll_limit ),
+                boost::false_type, boost::integral_constant<std::size_t, pattern_length> >::type dispatch;
+            return mismatch ( curPos, dispatch ());
+            }
+
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            corpusIter curPos = corpus_first;
+            const corpusIter lastPos = corpus_last - pattern_length;
+            while ( curPos <= lastPos ) {
+            //  Do we match right where we are?
+                const difference_type j = mismatch ( curPos );
+                if ( j == 0 )
+                    return curPos;
+
+            //  Since we didn't match, figure out how far to skip forward
+                const difference_type k = tables.bad_char ( curPos [ j - 1 ] );
+                const difference_type m = j - k - 1;
+                if ( k < j && m > tables.suffix [ j ] )
+                    curPos += m;
+                else
+                    curPos += tables.suffix [ j ];
+                }
+
+            return corpus_last;     // We didn't find anything
+            }
+/// \endcond
+        };
+
+//  Definitions of the static data (needed before C++17)
+    template <typename charT, charT... Pattern>
+    constexpr charT static_boyer_moore<charT, Pattern...>::pattern [ static_boyer_moore<charT, Pattern...>::pattern_length + 1 ];
+
+    template <typename charT, charT... Pattern>
+    constexpr typename static_boyer_moore<charT, Pattern...>::tables_type static_boyer_moore<charT, Pattern...>::tables;
+
+/// \fn static_boyer_moore_search ( corpusIter corpus_first, corpusIter corpus_last )
+/// \brief Searches the corpus for the pattern given as template arguments.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+///
+    template <typename charT, charT... Pattern, typename corpusIter>
+    corpusIter static_boyer_moore_search ( corpusIter corpus_first, corpusIter corpus_last ) {
+        return static_boyer_moore<charT, Pattern...> () ( corpus_first, corpus_last );
+        }
+
+}}
+
+#endif  // !BOOST_NO_CXX14_CONSTEXPR && !BOOST_NO_CXX11_VARIADIC_TEMPLATES
+
+#endif  //  BOOST_ALGORITHM_STATIC_BOYER_MOORE_SEARCH_HPP
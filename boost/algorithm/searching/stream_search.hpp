@@ -0,0 +1,239 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_STREAM_SEARCH_HPP
+#define BOOST_ALGORITHM_STREAM_SEARCH_HPP
+
+#include <vector>
+#include <algorithm>    // for std::min, std::max
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Streaming front ends for the Knuth-Morris-Pratt and Boyer-Moore-Horspool searches.
+
+    The corpus is passed in as a series of chunks, by calling 'feed' once per chunk.
+    Matches may straddle the boundaries between chunks. Since the chunks are
+    not expected to outlive the call to 'feed', matches are reported as offsets
+    from the start of the stream, rather than as iterators.
+
+    The state carried from one chunk to the next is bounded by the length of
+    the pattern; the stream is never collected into a single buffer:
+        * knuth_morris_pratt_stream keeps the length of the current partial match
+        * boyer_moore_horspool_stream keeps (a copy of) the last pattern_length-1 elements
+
+    Requirements:
+        * Random access iterators for the pattern
+        * Input iterators for the chunks (knuth_morris_pratt_stream)
+          Random access iterators for the chunks (boyer_moore_horspool_stream)
+        * The two iterator types must "point to" the same underlying type.
+*/
+
+    template <typename patIter>
+    class knuth_morris_pratt_stream {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+    public:
+        typedef boost::uintmax_t position_type;
+
+        /// \fn knuth_morris_pratt_stream ( patIter first, patIter last, bool overlapping )
+        /// \param first        The start of the pattern to search for (Random Access Iterator)
+        /// \param last         One past the end of the pattern
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        knuth_morris_pratt_stream ( patIter first, patIter last, bool overlapping = true )
+            : kmp_ ( first, last ), k_overlapping ( overlapping ), pos_ ( 0 ), idx_ ( 0 ) {}
+
+        ~knuth_morris_pratt_stream () {}
+
+        /// \fn feed ( corpusIter chunk_first, corpusIter chunk_last, OutputIterator out )
+        /// \brief Searches the next chunk of the stream
+        ///
+        /// \param chunk_first  The start of the chunk
+        /// \param chunk_last   One past the end of the chunk
+        /// \param out          An output iterator which receives the stream offset (position_type)
+        ///                     of the start of each match
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator feed ( corpusIter chunk_first, corpusIter chunk_last, OutputIterator out ) {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            const patIter pat_first = kmp_.pat_first;
+            const difference_type k_pattern_length = kmp_.k_pattern_length;
+            if ( k_pattern_length == 0 ) {  // empty pattern matches at start
+                if ( pos_ == 0 && chunk_first != chunk_last )
+                    *out++ = position_type ( 0 );
+                pos_ += std::distance ( chunk_first, chunk_last );
+                return out;
+                }
+
+            const std::vector<difference_type> &skip = kmp_.skip_;
+            for ( ; chunk_first != chunk_last; ++chunk_first ) {
+                ++pos_;
+                while ( idx_ >= 0 && !( pat_first [ idx_ ] == *chunk_first ))
+                    idx_ = skip [ idx_ ];
+                if ( ++idx_ == k_pattern_length ) {
+                    *out++ = pos_ - k_pattern_length;
+                    idx_ = k_overlapping ? skip [ idx_ ] : 0;
+                    }
+                }
+            return out;
+            }
+
+        /// \fn position () const
+        /// \brief Returns the number of elements that have been fed to the searcher
+        position_type position () const { return pos_; }
+
+        /// \fn reset ()
+        /// \brief Start searching a new stream
+        void reset () { pos_ = 0; idx_ = 0; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        knuth_morris_pratt<patIter> kmp_;
+        const bool k_overlapping;
+        position_type pos_;         // how much of the stream we have seen
+        difference_type idx_;       // how much of the pattern matches the end of what we've seen
+/// \endcond
+        };
+
+
+    template <typename patIter, typename traits = detail::BM_traits<patIter> >
+    class boyer_moore_horspool_stream {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename detail::traits_fold<traits>::type fold_type;
+    public:
+        typedef boost::uintmax_t position_type;
+
+        /// \fn boyer_moore_horspool_stream ( patIter first, patIter last, bool overlapping )
+        /// \param first        The start of the pattern to search for (Random Access Iterator)
+        /// \param last         One past the end of the pattern
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        boyer_moore_horspool_stream ( patIter first, patIter last, bool overlapping = true )
+            : bmh_ ( first, last ), k_overlapping ( overlapping ), pos_ ( 0 ), next_ ( 0 ) {
+            carry_.reserve ( 2 * bmh_.k_pattern_length );
+            }
+
+        ~boyer_moore_horspool_stream () {}
+
+        /// \fn feed ( corpusIter chunk_first, corpusIter chunk_last, OutputIterator out )
+        /// \brief Searches the next chunk of the stream
+        ///
+        /// \param chunk_first  The start of the chunk (Random Access Iterator)
+        /// \param chunk_last   One past the end of the chunk
+        /// \param out          An output iterator which receives the stream offset (position_type)
+        ///                     of the start of each match
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator feed ( corpusIter chunk_first, corpusIter chunk_last, OutputIterator out ) {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            const difference_type k_pattern_length = bmh_.k_pattern_length;
+            const difference_type k_chunk_length = std::distance ( chunk_first, chunk_last );
+            if ( k_pattern_length == 0 ) {  // empty pattern matches at start
+                if ( pos_ == 0 && k_chunk_length != 0 )
+                    *out++ = position_type ( 0 );
+                pos_ += k_chunk_length;
+                return out;
+                }
+
+            const position_type chunk_pos = pos_;
+            pos_ += k_chunk_length;
+
+        //  First, the windows that start in the carried-over elements and end in this chunk.
+        //  Put the two pieces together - at most 2 * (pattern_length - 1) elements.
+            if ( !carry_.empty ()) {
+                const difference_type head = (std::min) ( k_chunk_length, k_pattern_length - 1 );
+                carry_.insert ( carry_.end (), chunk_first, chunk_first + head );
+                const position_type carry_pos = pos_ - k_chunk_length + head - carry_.size ();
+                out = this->scan ( carry_.begin (), carry_pos, carry_pos + carry_.size (), chunk_pos, out );
+                if ( head < k_chunk_length )
+                    carry_.clear ();
+                }
+
+        //  Then the windows that lie entirely inside this chunk
+            out = this->scan ( chunk_first, chunk_pos, pos_, pos_, out );
+
+        //  Keep the elements that the next window might start in
+            if ( next_ < pos_ ) {
+                const difference_type keep = (std::min) ( difference_type ( pos_ - next_ ), k_pattern_length - 1 );
+                if ( carry_.empty ())
+                    carry_.assign ( chunk_last - (std::min) ( keep, k_chunk_length ), chunk_last );
+                else
+                    carry_.erase ( carry_.begin (), carry_.end () - (std::min) ( keep, difference_type ( carry_.size ())));
+                }
+            else
+                carry_.clear ();
+            return out;
+            }
+
+        /// \fn position () const
+        /// \brief Returns the number of elements that have been fed to the searcher
+        position_type position () const { return pos_; }
+
+        /// \fn reset ()
+        /// \brief Start searching a new stream
+        void reset () { pos_ = 0; next_ = 0; carry_.clear (); }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        boyer_moore_horspool<patIter, traits> bmh_;
+        const bool k_overlapping;
+        position_type pos_;             // how much of the stream we have seen
+        position_type next_;            // where the next window starts
+        std::vector<value_type> carry_; // the end of the stream, where the next window may start
+
+    //  Check each window that starts before 'start_limit' and ends by 'end_limit',
+    //  beginning at 'next_'. The element at stream offset 'p' is base [ p - base_pos ].
+        template <typename Iter, typename OutputIterator>
+        OutputIterator scan ( Iter base, position_type base_pos,
+                    position_type end_limit, position_type start_limit, OutputIterator out ) {
+            const patIter pat_first = bmh_.pat_first;
+            const difference_type k_pattern_length = bmh_.k_pattern_length;
+            BOOST_ASSERT ( next_ >= base_pos || next_ + k_pattern_length > end_limit );
+            while ( next_ < start_limit && next_ + k_pattern_length <= end_limit ) {
+                const Iter curPos = base + difference_type ( next_ - base_pos );
+                difference_type j = k_pattern_length - 1;
+                bool matched = false;
+                while ( fold_type::apply ( pat_first [j] ) == fold_type::apply ( curPos [j] )) {
+                    if ( j == 0 ) {
+                        *out++ = next_;
+                        matched = true;
+                        break;
+                        }
+                    j--;
+                    }
+                if ( matched && !k_overlapping )
+                    next_ += k_pattern_length;
+                else
+                    next_ += bmh_.skip_ [ fold_type::apply ( curPos [ k_pattern_length - 1 ] ) ];
+                }
+            return out;
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_STREAM_SEARCH_HPP
@@ -0,0 +1,466 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  suffix_array.hpp
+/// \brief An index of a corpus (a suffix array), for answering many queries
+///     about the same corpus without scanning it each time.
+/// \author Marshall Clow
+
+#ifndef BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
+#define BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
+
+#include <algorithm>    // for std::sort, std::fill, std::min
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memcpy, std::memcmp
+#include <iterator>     // for std::iterator_traits
+#include <ostream>
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    The searchers preprocess the pattern, and scan the whole corpus for each one.
+    When the corpus doesn't change, and there are many queries, it is better to
+    preprocess the corpus instead. A suffix array is the list of the positions in
+    the corpus, sorted by the suffix of the corpus that starts there; the
+    occurrences of any pattern are then a contiguous run of it, found by binary
+    search.
+
+    The array is built in linear time, with the SA-IS algorithm. A query compares
+    the pattern with O(log n) suffixes; the comparisons skip the prefix that is
+    already known to match (Manber and Myers' "mlr" rule), so most of them look at
+    only a few elements. Counting the occurrences of a pattern of length m costs
+    O(m log n) in the worst case, and typically O(m + log n); listing them costs
+    O(occ log occ) more, since they are returned in corpus order.
+
+    The array can be written out with 'write', and used straight from memory (say,
+    a file mapped with mapped_corpus) by a later process, without building it again.
+    The corpus itself is not part of the file. The layout (version 1) is, in the
+    byte order of the machine that wrote it:
+        char    magic [ 8 ]         "BALGSUFA"
+        uint32  version             1
+        uint32  byte order mark     0x01020304
+        uint64  corpus length (n)
+        uint32  index width         4 or 8 (8 for corpora of 2GB or more)
+        uint32  reserved            0
+        int32 or int64              the suffix array [ n ]
+
+    A file that is damaged, from a different version or byte order, or for a
+    corpus of a different length, is rejected with suffix_array_error; so is
+    one with an entry that is not a position in the corpus.
+
+    Requirements:
+        * The elements of the corpus and the pattern are bytes (char, signed char or unsigned char)
+        * Random access iterators for the corpus and the pattern
+        * The corpus must not change, or move, while the index is in use
+
+    G. Nong, S. Zhang and W. H. Chan, "Two efficient algorithms for linear
+        time suffix array construction", IEEE Trans. Computers 60 (2011)
+    U. Manber and G. Myers, "Suffix arrays: a new method for on-line string
+        searches", SIAM J. Computing 22 (1993)
+*/
+
+/*!
+    \struct suffix_array_error
+    \brief  Thrown when a saved suffix array cannot be written or used.
+*/
+struct suffix_array_error: virtual boost::exception, virtual std::exception {};
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  The corpus, as SA-IS sees it: the bytes are 1 .. 256, and there is a
+//  sentinel (0), smaller than everything else, at the end.
+    template <typename Iter>
+    struct sais_byte_string {
+        sais_byte_string ( Iter first, std::size_t n ) : first_ ( first ), n_ ( n ) {}
+        unsigned operator [] ( std::size_t i ) const {
+            return i == n_ ? 0U : 1U + static_cast<unsigned char> ( first_ [ i ] );
+            }
+        Iter first_;
+        std::size_t n_;
+        };
+
+//  A "leftmost S-type" position: an S-type suffix, just after an L-type one
+    template <typename Index>
+    bool sais_is_lms ( const std::vector<bool> &t, Index i ) {
+        return i > 0 && t [ i ] && !t [ i - 1 ];
+        }
+
+    template <typename Str, typename Index>
+    void sais_buckets ( const Str &s, std::vector<Index> &bkt, Index n, Index k, bool end ) {
+        std::fill ( bkt.begin (), bkt.begin () + k, Index ( 0 ));
+        for ( Index i = 0; i < n; ++i )
+            ++bkt [ s [ i ]];
+        Index sum = 0;
+        for ( Index i = 0; i < k; ++i ) {
+            sum += bkt [ i ];
+            bkt [ i ] = end ? sum : sum - bkt [ i ];
+            }
+        }
+
+    template <typename Str, typename Index>
+    void sais_induce ( const Str &s, Index *sa, const std::vector<bool> &t,
+                        std::vector<Index> &bkt, Index n, Index k ) {
+    //  The L-type suffixes, from the left, into the starts of their buckets
+        sais_buckets ( s, bkt, n, k, false );
+        for ( Index i = 0; i < n; ++i ) {
+            const Index j = sa [ i ] - 1;
+            if ( sa [ i ] > 0 && !t [ j ] )
+                sa [ bkt [ s [ j ]]++ ] = j;
+            }
+    //  Then the S-type ones, from the right, into the ends
+        sais_buckets ( s, bkt, n, k, true );
+        for ( Index i = n; i-- > 0; ) {
+            const Index j = sa [ i ] - 1;
+            if ( sa [ i ] > 0 && t [ j ] )
+                sa [ --bkt [ s [ j ]]] = j;
+            }
+        }
+
+//  Builds the suffix array of s [0, n) into sa. The alphabet is [0, k), and
+//  s [n-1] must be a unique, smallest, sentinel.
+    template <typename Str, typename Index>
+    void sais ( const Str &s, Index *sa, Index n, Index k ) {
+        if ( n == 1 ) {
+            sa [ 0 ] = 0;
+            return;
+            }
+
+    //  Classify the suffixes; t [i] is true if suffix i is S-type (smaller than suffix i+1)
+        std::vector<bool> t ( n );
+        t [ n - 1 ] = true;
+        t [ n - 2 ] = false;
+        for ( Index i = n - 2; i-- > 0; )
+            t [ i ] = s [ i ] < s [ i + 1 ] || ( s [ i ] == s [ i + 1 ] && t [ i + 1 ] );
+
+    //  Sort the LMS substrings, by putting them in their buckets and inducing
+        std::vector<Index> bkt ( k );
+        sais_buckets ( s, bkt, n, k, true );
+        std::fill ( sa, sa + n, Index ( -1 ));
+        for ( Index i = 1; i < n; ++i )
+            if ( sais_is_lms ( t, i ))
+                sa [ --bkt [ s [ i ]]] = i;
+        sais_induce ( s, sa, t, bkt, n, k );
+
+    //  Move the sorted LMS substrings to the front, and name them
+        Index n1 = 0;
+        for ( Index i = 0; i < n; ++i )
+            if ( sais_is_lms ( t, sa [ i ] ))
+                sa [ n1++ ] = sa [ i ];
+        std::fill ( sa + n1, sa + n, Index ( -1 ));
+        Index name = 0, prev = -1;
+        for ( Index i = 0; i < n1; ++i ) {
+            const Index pos = sa [ i ];
+            bool diff = false;
+            for ( Index d = 0; d < n; ++d ) {
+                if ( prev == -1 || s [ pos + d ] != s [ prev + d ] || t [ pos + d ] != t [ prev + d ] ) {
+                    diff = true;
+                    break;
+                    }
+                if ( d > 0 && ( sais_is_lms ( t, pos + d ) || sais_is_lms ( t, prev + d )))
+                    break;
+                }
+            if ( diff ) {
+                ++name;
+                prev = pos;
+                }
+            sa [ n1 + pos / 2 ] = name - 1;
+            }
+        for ( Index i = n, j = n; i-- > n1; )
+            if ( sa [ i ] >= 0 )
+                sa [ --j ] = sa [ i ];
+
+    //  Sort the LMS suffixes; recursively, if their names are not all different
+        Index *s1 = sa + n - n1;
+        if ( name < n1 )
+            sais ( s1, sa, n1, name );
+        else
+            for ( Index i = 0; i < n1; ++i )
+                sa [ s1 [ i ]] = i;
+
+    //  Put the sorted LMS suffixes in their buckets, and induce the rest
+        for ( Index i = 1, j = 0; i < n; ++i )
+            if ( sais_is_lms ( t, i ))
+                s1 [ j++ ] = i;
+        for ( Index i = 0; i < n1; ++i )
+            sa [ i ] = s1 [ sa [ i ]];
+        std::fill ( sa + n1, sa + n, Index ( -1 ));
+        sais_buckets ( s, bkt, n, k, true );
+        for ( Index i = n1; i-- > 0; ) {
+            const Index j = sa [ i ];
+            sa [ i ] = -1;
+            sa [ --bkt [ s [ j ]]] = j;
+            }
+        sais_induce ( s, sa, t, bkt, n, k );
+        }
+
+    struct suffix_array_layout {
+        BOOST_STATIC_CONSTANT ( std::size_t, k_header_size = 8 + 4 + 4 + 8 + 4 + 4 );
+        BOOST_STATIC_CONSTANT ( boost::uint32_t, k_version = 1 );
+        BOOST_STATIC_CONSTANT ( boost::uint32_t, k_byte_order = 0x01020304 );
+        static const char *magic () { return "BALGSUFA"; }
+        };
+}
+/// \endcond
+
+    template <typename corpusIter>
+    class suffix_array : boost::noncopyable {
+        typedef typename std::iterator_traits<corpusIter>::value_type value_type;
+        BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+    public:
+        /// \fn suffix_array ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Builds the index of the corpus
+        ///
+        /// \param corpus_first The start of the corpus (Random Access Iterator)
+        /// \param corpus_last  One past the end of the corpus
+        ///
+        suffix_array ( corpusIter corpus_first, corpusIter corpus_last )
+                : corpus_first_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                  n_ ( std::distance ( corpus_first, corpus_last )), sa32_ ( NULL ), sa64_ ( NULL ) {
+        //  The sentinel takes a slot too; and SA-IS needs signed indices
+            if ( n_ + 1 < 0x7FFFFFFFUL )
+                sa32_ = this->build ( own32_ );
+            else
+                sa64_ = this->build ( own64_ );
+            }
+
+        /// \fn suffix_array ( corpusIter corpus_first, corpusIter corpus_last, const void *data, std::size_t size )
+        /// \brief Uses an index that was saved with 'write'; nothing is copied
+        ///
+        /// \param corpus_first The start of the corpus (Random Access Iterator)
+        /// \param corpus_last  One past the end of the corpus
+        /// \param data         The saved index; it must be aligned for its index width
+        /// \param size         The size of the saved index, in bytes
+        ///
+        suffix_array ( corpusIter corpus_first, corpusIter corpus_last, const void *data, std::size_t size )
+                : corpus_first_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                  n_ ( std::distance ( corpus_first, corpus_last )), sa32_ ( NULL ), sa64_ ( NULL ) {
+            typedef detail::suffix_array_layout layout;
+            const unsigned char *bytes = static_cast<const unsigned char *> ( data );
+            if ( size < layout::k_header_size
+                    || std::memcmp ( bytes, layout::magic (), 8 ) != 0
+                    || get<boost::uint32_t> ( bytes +  8 ) != layout::k_version
+                    || get<boost::uint32_t> ( bytes + 12 ) != layout::k_byte_order
+                    || get<boost::uint64_t> ( bytes + 16 ) != static_cast<boost::uint64_t> ( n_ ))
+                BOOST_THROW_EXCEPTION ( suffix_array_error ());
+
+            const boost::uint32_t width = get<boost::uint32_t> ( bytes + 24 );
+            if (( width != 4 && width != 8 )
+                    || reinterpret_cast<std::size_t> ( data ) % width != 0
+                    || ( size - layout::k_header_size ) / width < n_ )
+                BOOST_THROW_EXCEPTION ( suffix_array_error ());
+            if ( width == 4 )
+                sa32_ = reinterpret_cast<const boost::int32_t *> ( bytes + layout::k_header_size );
+            else
+                sa64_ = reinterpret_cast<const boost::int64_t *> ( bytes + layout::k_header_size );
+            if ( sa32_ != NULL ? !this->in_range ( sa32_ ) : !this->in_range ( sa64_ ))
+                BOOST_THROW_EXCEPTION ( suffix_array_error ());
+            }
+
+        ~suffix_array () {}
+
+        /// The length of the corpus
+        std::size_t size () const { return n_; }
+
+        /// \fn suffix ( std::size_t i )
+        /// \brief The position in the corpus of the i'th smallest suffix
+        std::size_t suffix ( std::size_t i ) const {
+            return sa64_ == NULL ? static_cast<std::size_t> ( sa32_ [ i ] ) : static_cast<std::size_t> ( sa64_ [ i ] );
+            }
+
+        /// \fn count ( patIter pat_first, patIter pat_last )
+        /// \brief The number of (possibly overlapping) occurrences of the pattern in the corpus
+        ///
+        template <typename patIter>
+        std::size_t count ( patIter pat_first, patIter pat_last ) const {
+            const std::pair<std::size_t, std::size_t> r = this->equal_range ( pat_first, pat_last );
+            return r.second - r.first;
+            }
+
+        template <typename Range>
+        std::size_t count ( const Range &pattern ) const {
+            return this->count ( boost::begin ( pattern ), boost::end ( pattern ));
+            }
+
+        /// \fn locate ( patIter pat_first, patIter pat_last, OutputIterator out )
+        /// \brief Writes an iterator to the start of every occurrence of the pattern, in corpus order
+        ///
+        /// Like the find_all member functions of the searchers (with overlapping
+        /// matches), an empty pattern matches once, at the start of the corpus.
+        ///
+        template <typename patIter, typename OutputIterator>
+        OutputIterator locate ( patIter pat_first, patIter pat_last, OutputIterator out ) const {
+            if ( corpus_first_ == corpus_last_ ) return out;
+            if ( pat_first == pat_last ) {
+                *out++ = corpus_first_;
+                return out;
+                }
+            const std::pair<std::size_t, std::size_t> r = this->equal_range ( pat_first, pat_last );
+            std::vector<std::size_t> positions;
+            positions.reserve ( r.second - r.first );
+            for ( std::size_t i = r.first; i < r.second; ++i )
+                positions.push_back ( this->suffix ( i ));
+            std::sort ( positions.begin (), positions.end ());
+            for ( std::size_t i = 0; i < positions.size (); ++i )
+                *out++ = corpus_first_ + positions [ i ];
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator locate ( const Range &pattern, OutputIterator out ) const {
+            return this->locate ( boost::begin ( pattern ), boost::end ( pattern ), out );
+            }
+
+        /// \fn find_first ( patIter pat_first, patIter pat_last )
+        /// \brief Finds the first occurrence of the pattern in the corpus
+        ///
+        /// Returns what the searchers do: an iterator to the start of the first match,
+        /// or the end of the corpus if there is none.
+        ///
+        template <typename patIter>
+        corpusIter find_first ( patIter pat_first, patIter pat_last ) const {
+            if ( corpus_first_ == corpus_last_ ) return corpus_last_;  // if nothing to search, we didn't find it!
+            if ( pat_first == pat_last )         return corpus_first_; // empty pattern matches at start
+            const std::pair<std::size_t, std::size_t> r = this->equal_range ( pat_first, pat_last );
+            if ( r.first == r.second )
+                return corpus_last_;
+            std::size_t best = this->suffix ( r.first );
+            for ( std::size_t i = r.first + 1; i < r.second; ++i )
+                best = (std::min) ( best, this->suffix ( i ));
+            return corpus_first_ + best;
+            }
+
+        template <typename Range>
+        corpusIter find_first ( const Range &pattern ) const {
+            return this->find_first ( boost::begin ( pattern ), boost::end ( pattern ));
+            }
+
+        /// \fn write ( std::ostream &out )
+        /// \brief Saves the index (but not the corpus); 'out' should be opened in binary mode
+        ///
+        void write ( std::ostream &out ) const {
+            typedef detail::suffix_array_layout layout;
+            out.write ( layout::magic (), 8 );
+            put<boost::uint32_t> ( out, layout::k_version );
+            put<boost::uint32_t> ( out, layout::k_byte_order );
+            put<boost::uint64_t> ( out, n_ );
+            put<boost::uint32_t> ( out, sa64_ == NULL ? 4 : 8 );
+            put<boost::uint32_t> ( out, 0 );
+            if ( n_ > 0 ) {
+                if ( sa64_ == NULL )
+                    out.write ( reinterpret_cast<const char *> ( sa32_ ), n_ * sizeof ( boost::int32_t ));
+                else
+                    out.write ( reinterpret_cast<const char *> ( sa64_ ), n_ * sizeof ( boost::int64_t ));
+                }
+            if ( !out )
+                BOOST_THROW_EXCEPTION ( suffix_array_error ());
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        corpusIter corpus_first_, corpus_last_;
+        const std::size_t n_;
+        std::vector<boost::int32_t> own32_;     // when we built the index, rather than loaded it
+        std::vector<boost::int64_t> own64_;
+        const boost::int32_t *sa32_;            // one of these is the index
+        const boost::int64_t *sa64_;
+
+        template <typename Index>
+        const Index *build ( std::vector<Index> &sa ) {
+            sa.resize ( n_ + 1 );
+            detail::sais ( detail::sais_byte_string<corpusIter> ( corpus_first_, n_ ),
+                            &sa [ 0 ], Index ( n_ + 1 ), Index ( 257 ));
+            sa.erase ( sa.begin ());     // the sentinel is the smallest suffix
+            return sa.empty () ? NULL : &sa [ 0 ];
+            }
+
+    //  The searches index the corpus with the entries; they must all be in it
+        template <typename Index>
+        bool in_range ( const Index *sa ) const {
+            for ( std::size_t i = 0; i < n_; ++i )
+                if ( sa [ i ] < 0 || static_cast<boost::uint64_t> ( sa [ i ] ) >= n_ )
+                    return false;
+            return true;
+            }
+
+    //  Compare the suffix at 'pos' with the pattern, starting 'k' elements in
+    //  (the ones before that are known to match). Returns the length of the common
+    //  prefix, and sets 'less' if the suffix sorts before the pattern.
+        template <typename patIter>
+        std::size_t compare ( std::size_t pos, patIter pat_first, std::size_t m, std::size_t k, bool &less ) const {
+            const std::size_t avail = n_ - pos;
+            while ( k < m && k < avail &&
+                    static_cast<unsigned char> ( corpus_first_ [ pos + k ] ) == static_cast<unsigned char> ( pat_first [ k ] ))
+                ++k;
+            less = k < m && ( k == avail ||
+                    static_cast<unsigned char> ( corpus_first_ [ pos + k ] ) < static_cast<unsigned char> ( pat_first [ k ] ));
+            return k;
+            }
+
+    //  The first suffix that is not less than the pattern ('upper' is false), or
+    //  the first one that is greater and doesn't start with it ('upper' is true)
+        template <typename patIter>
+        std::size_t bound ( patIter pat_first, std::size_t m, bool upper ) const {
+            std::size_t lo = 0, hi = n_;
+            std::size_t llcp = 0, rlcp = 0;     // the common prefixes of the pattern and the suffixes at lo-1 and hi
+            while ( lo < hi ) {
+                const std::size_t mid = lo + ( hi - lo ) / 2;
+                bool less;
+                const std::size_t l = this->compare ( this->suffix ( mid ), pat_first, m,
+                                                        (std::min) ( llcp, rlcp ), less );
+                if ( less || ( upper && l == m )) {
+                    lo = mid + 1;
+                    llcp = l;
+                    }
+                else {
+                    hi = mid;
+                    rlcp = l;
+                    }
+                }
+            return lo;
+            }
+
+        template <typename patIter>
+        std::pair<std::size_t, std::size_t> equal_range ( patIter pat_first, patIter pat_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_integral<typename std::iterator_traits<patIter>::value_type>::value
+                            && sizeof ( typename std::iterator_traits<patIter>::value_type ) == 1 ));
+            const std::size_t m = std::distance ( pat_first, pat_last );
+            if ( m == 0 )
+                return std::make_pair ( std::size_t ( 0 ), n_ );
+            return std::make_pair ( this->bound ( pat_first, m, false ), this->bound ( pat_first, m, true ));
+            }
+
+        template <typename T>
+        static T get ( const unsigned char *p ) {
+            T val;
+            std::memcpy ( &val, p, sizeof ( T ));
+            return val;
+            }
+
+        template <typename T>
+        static void put ( std::ostream &out, T val ) {
+            out.write ( reinterpret_cast<const char *> ( &val ), sizeof ( T ));
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
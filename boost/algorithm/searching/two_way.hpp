@@ -0,0 +1,276 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_TWO_WAY_SEARCH_HPP
+#define BOOST_ALGORITHM_TWO_WAY_SEARCH_HPP
+
+#include <algorithm>    // for std::max, std::equal
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A templated version of the Two-Way (Crochemore-Perrin) searching algorithm.
+
+    The pattern is split at a "critical factorization" into a left and a right
+    part. At each position, the right part is compared left-to-right, and then
+    the left part right-to-left. The shifts depend only on the period of the
+    pattern, which is computed (along with the split) when the searcher is built.
+
+    The search takes linear time in the worst case (at most 2n comparisons),
+    and the searcher uses a constant amount of memory; it never allocates.
+    This makes it a good choice for long or periodic patterns, and for
+    patterns or corpora which come from an untrusted source.
+
+    Requirements:
+        * Random-access iterators
+        * The two iterator types must "point to" the same underlying type.
+        * The underlying type must be LessThanComparable (to find the critical factorization)
+
+    http://www-igm.univ-mlv.fr/~lecroq/string/node26.html
+    M. Crochemore and D. Perrin, "Two-way string-matching", J. ACM 38 (1991)
+*/
+
+    template <typename patIter>
+    class two_way {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+    public:
+        two_way ( patIter first, patIter last )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  ell_ ( -1 ), period_ ( 1 ), periodic_ ( false ) {
+            if ( k_pattern_length > 0 )
+                this->factorize ();
+            }
+
+        ~two_way () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if ( pat_first == pat_last )       return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+            difference_type match_start = 0;
+            difference_type memory = -1;
+            if ( this->find_next ( corpus_first, k_corpus_length - k_pattern_length, match_start, memory ))
+                return corpus_first + match_start;
+            return corpus_last;     // We didn't find anything
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, bool overlapping )
+        /// \brief Searches the corpus for every occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an iterator to the start of each match
+        /// \param overlapping  If false, matches that overlap an earlier match are not reported
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, bool overlapping = true ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if ( pat_first == pat_last ) {                  // empty pattern matches at start
+                *out++ = corpus_first;
+                return out;
+                }
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return out;
+
+            const difference_type last_match = k_corpus_length - k_pattern_length;
+            difference_type match_start = 0;
+            difference_type memory = -1;
+            while ( this->find_next ( corpus_first, last_match, match_start, memory )) {
+                *out++ = corpus_first + match_start;
+            //  Either shift by the period (remembering the part that we know matches), or past the match
+                if ( overlapping ) {
+                    match_start += period_;
+                    if ( periodic_ )
+                        memory = k_pattern_length - period_ - 1;
+                    }
+                else {
+                    match_start += k_pattern_length;
+                    memory = -1;
+                    }
+                }
+            return out;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        difference_type ell_;       // the critical position is ell_ + 1
+        difference_type period_;    // the shift after a match
+        bool periodic_;             // the pattern is periodic, and we remember matched prefixes
+
+        /// \fn find_next ( corpusIter corpus_first, difference_type last_match,
+        ///                 difference_type &match_start, difference_type &memory )
+        /// \brief Resumes the search at 'match_start', with the first 'memory' + 1 elements
+        ///        of the pattern already known to match there
+        ///
+        /// On success, 'match_start' is the position of the match.
+        template <typename corpusIter>
+        bool find_next ( corpusIter corpus_first, difference_type last_match,
+                difference_type &match_start, difference_type &memory ) const {
+            while ( match_start <= last_match ) {
+                const corpusIter curPos = corpus_first + match_start;
+
+            //  Compare the right part, left to right
+                difference_type i = (std::max) ( ell_, memory ) + 1;
+                while ( i < k_pattern_length && pat_first [ i ] == curPos [ i ] )
+                    ++i;
+                if ( i < k_pattern_length ) {
+                    match_start += i - ell_;
+                    memory = -1;
+                    continue;
+                    }
+
+            //  Then the left part, right to left
+                i = ell_;
+                while ( i > memory && pat_first [ i ] == curPos [ i ] )
+                    --i;
+                if ( i <= memory )
+                    return true;
+
+                match_start += period_;
+                memory = periodic_ ? k_pattern_length - period_ - 1 : -1;
+                }
+            return false;
+            }
+
+    //  Returns the position before the start of the maximal suffix of the pattern,
+    //  (under '<', or the reverse of '<' if 'invert' is true) and its period in 'period'.
+        difference_type maximal_suffix ( bool invert, difference_type &period ) const {
+            difference_type ms = -1;    // the maximal suffix starts at ms + 1
+            difference_type j = 0;
+            difference_type k = 1;
+            period = 1;
+            while ( j + k < k_pattern_length ) {
+                const bool a_less_b = invert
+                    ? pat_first [ ms + k ] < pat_first [ j + k ]
+                    : pat_first [ j + k ] < pat_first [ ms + k ];
+                if ( a_less_b ) {
+                    j += k;
+                    k = 1;
+                    period = j - ms;
+                    }
+                else if ( pat_first [ j + k ] == pat_first [ ms + k ] ) {
+                    if ( k != period )
+                        ++k;
+                    else {
+                        j += period;
+                        k = 1;
+                        }
+                    }
+                else {
+                    ms = j;
+                    j = ms + 1;
+                    k = period = 1;
+                    }
+                }
+            return ms;
+            }
+
+    //  Find the critical factorization, and decide whether the pattern is periodic
+        void factorize () {
+            difference_type p, q;
+            const difference_type i = this->maximal_suffix ( false, p );
+            const difference_type j = this->maximal_suffix ( true,  q );
+            if ( i > j ) {
+                ell_ = i;
+                period_ = p;
+                }
+            else {
+                ell_ = j;
+                period_ = q;
+                }
+            BOOST_ASSERT ( ell_ + 1 < k_pattern_length );
+
+        //  Is the left part a suffix of the prefix of length period_ + ell_ + 1?
+            periodic_ = period_ + ell_ + 1 <= k_pattern_length &&
+                        std::equal ( pat_first, pat_first + ell_ + 1, pat_first + period_ );
+            if ( !periodic_ )
+                period_ = (std::max) ( ell_ + 1, k_pattern_length - ell_ - 1 ) + 1;
+            }
+/// \endcond
+        };
+
+
+/// \fn two_way_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter two_way_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        two_way<patIter> tw ( pat_first, pat_last );
+        return tw ( corpus_first, corpus_last );
+        }
+
+/// \fn two_way_find_all ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last, OutputIterator out, bool overlapping )
+/// \brief Searches the corpus for every occurrence of the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param out          An output iterator which receives an iterator to the start of each match
+/// \param overlapping  If false, matches that overlap an earlier match are not reported
+///
+    template <typename patIter, typename corpusIter, typename OutputIterator>
+    OutputIterator two_way_find_all (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last,
+            OutputIterator out, bool overlapping = true ) {
+        two_way<patIter> tw ( pat_first, pat_last );
+        return tw.find_all ( corpus_first, corpus_last, out, overlapping );
+        }
+
+}}
+
+#endif  // BOOST_ALGORITHM_TWO_WAY_SEARCH_HPP
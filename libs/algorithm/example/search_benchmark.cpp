@@ -0,0 +1,350 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/chrono.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool_simd.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool_rare.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool_qgram.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/two_way.hpp>
+#include <boost/algorithm/searching/shift_or.hpp>
+#include <boost/algorithm/searching/adaptive_searcher.hpp>
+
+//  A benchmark of the searchers, which writes its results as JSON (to stdout, or to a file).
+//
+//  usage: search_benchmark [--quick] [--reps N] [--data-dir DIR] [--out FILE] [--tuning FILE]
+//
+//  Every searcher is run over a matrix of generated corpora (binary, DNA, English
+//  words and random bytes, of several sizes) and pattern lengths, and then over the
+//  corpus and patterns in the test data-files directory. The corpora are built from
+//  a fixed seed, so every run (on every platform) searches the same data.
+//
+//  For each combination, the report has:
+//      median_gbps     throughput of a search of the whole corpus (finding every match)
+//      median_ms       the median time of that search
+//      p99_ms          the 99th percentile time of that search
+//      construct_ns    the average time to construct the searcher (build its tables)
+//
+//  With --tuning, the searcher_tuning table for make_searcher is calibrated from the
+//  generated corpora: for each length and alphabet class, the engine with the
+//  lowest total time wins. The table is written to FILE, to be read with operator >>.
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::vector<char> vec;
+    typedef vec::const_iterator vec_iter;
+    typedef boost::chrono::steady_clock clock_type;
+
+//  A 64-bit linear congruential generator (Knuth's MMIX constants);
+//  unlike std::rand, it gives the same sequence everywhere.
+    class lcg {
+    public:
+        explicit lcg ( boost::uint64_t seed ) : state_ ( seed ) {}
+        boost::uint32_t operator () () {
+            state_ = state_ * ( boost::uint64_t ( 0x5851F42DUL ) << 32 | 0x4C957F2DUL )
+                            + ( boost::uint64_t ( 0x14057B7EUL ) << 32 | 0xF767814FUL );
+            return static_cast<boost::uint32_t> ( state_ >> 33 );
+            }
+    private:
+        boost::uint64_t state_;
+        };
+
+    const char *k_words [] = {
+        "the", "of", "and", "to", "in", "a", "is", "that", "for", "it", "as", "was", "with",
+        "be", "by", "on", "not", "he", "this", "are", "or", "his", "from", "at", "which",
+        "but", "have", "an", "had", "they", "you", "were", "their", "one", "all", "we",
+        "search", "pattern", "corpus", "algorithm", "boost", "library", "iterator", "table" };
+
+    vec make_corpus ( const std::string &alphabet, std::size_t size, boost::uint64_t seed ) {
+        lcg gen ( seed );
+        vec retVal;
+        retVal.reserve ( size + 16 );
+        if ( alphabet == "binary" )
+            while ( retVal.size () < size ) retVal.push_back ( "01" [ gen () % 2 ] );
+        else if ( alphabet == "dna" )
+            while ( retVal.size () < size ) retVal.push_back ( "ACGT" [ gen () % 4 ] );
+        else if ( alphabet == "random" )
+            while ( retVal.size () < size ) retVal.push_back ( static_cast<char> ( gen () & 0xFF ));
+        else {  // english; words, with the short ones more common
+            const std::size_t num_words = sizeof ( k_words ) / sizeof ( k_words [ 0 ] );
+            while ( retVal.size () < size ) {
+                const char *w = k_words [ ( gen () % num_words ) * ( gen () % num_words ) / num_words ];
+                retVal.insert ( retVal.end (), w, w + std::strlen ( w ));
+                retVal.push_back ( gen () % 16 == 0 ? '\n' : ' ' );
+                }
+            }
+        retVal.resize ( size );
+        return retVal;
+        }
+
+    vec read_file ( const std::string &name ) {
+        std::ifstream in ( name.c_str (), std::ios_base::binary | std::ios_base::in );
+        if ( !in ) {
+            std::cerr << "Can't open " << name << std::endl;
+            std::exit ( EXIT_FAILURE );
+            }
+        return vec ( std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char> ());
+        }
+
+//  std::search, with the same interface as the searcher objects
+    template <typename patIter>
+    class std_searcher {
+    public:
+        std_searcher ( patIter first, patIter last ) : pat_first ( first ), pat_last ( last ) {}
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            return std::search ( corpus_first, corpus_last, pat_first, pat_last );
+            }
+    private:
+        patIter pat_first, pat_last;
+        };
+
+//  Count every (overlapping) match, using only operator ()
+    template <typename Searcher>
+    std::size_t count_matches ( const Searcher &s, vec_iter first, vec_iter last ) {
+        std::size_t retVal = 0;
+        while (( first = s ( first, last )) != last ) {
+            ++retVal;
+            ++first;
+            }
+        return retVal;
+        }
+
+    double to_ms ( clock_type::duration d ) {
+        return boost::chrono::duration<double, boost::milli> ( d ).count ();
+        }
+
+//  Nearest-rank percentile of a sorted list
+    double percentile ( const std::vector<double> &sorted, double p ) {
+        std::size_t rank = static_cast<std::size_t> ( p / 100.0 * sorted.size () + 0.999999 );
+        rank = (std::max) ( rank, std::size_t ( 1 ));
+        return sorted [ (std::min) ( rank, sorted.size ()) - 1 ];
+        }
+
+    std::string json_string ( const std::string &s ) {
+        std::string retVal ( 1, '"' );
+        for ( std::string::const_iterator it = s.begin (); it != s.end (); ++it ) {
+            if ( *it == '"' || *it == '\\' ) retVal += '\\';
+            retVal += *it;
+            }
+        return retVal + '"';
+        }
+
+    struct bench_case {
+        std::string corpus_name;    // alphabet, or file name
+        std::string pattern_name;   // how the pattern was chosen
+        const vec  *corpus;
+        vec         pattern;
+        bool        calibrate;      // use the results for the tuning table
+        };
+
+    class benchmark {
+    public:
+        benchmark ( std::ostream &out, unsigned reps ) : out_ ( out ), k_reps ( reps ), first_ ( true ) {
+            std::fill_n ( &cell_ms_ [ 0 ][ 0 ][ 0 ], sizeof ( cell_ms_ ) / sizeof ( double ), 0.0 );
+            }
+
+        template <typename Searcher>
+        void run ( const char *searcher_name, const bench_case &bc, int engine = -1 ) {
+            const vec &corpus = *bc.corpus;
+            const vec &pattern = bc.pattern;
+
+        //  The cost of building the tables
+            const unsigned k_constructions = 200;
+            std::size_t sink = 0;
+            clock_type::time_point start = clock_type::now ();
+            for ( unsigned i = 0; i < k_constructions; ++i ) {
+                const Searcher s ( pattern.begin (), pattern.end ());
+                sink += s ( corpus.begin (), corpus.begin ()) == corpus.begin ();
+                }
+            const double construct_ns = boost::chrono::duration<double, boost::nano>
+                    ( clock_type::now () - start ).count () / k_constructions;
+
+        //  The search itself
+            const Searcher s ( pattern.begin (), pattern.end ());
+            std::vector<double> times;
+            std::size_t matches = 0;
+            for ( unsigned i = 0; i < k_reps; ++i ) {
+                start = clock_type::now ();
+                matches = count_matches ( s, corpus.begin (), corpus.end ());
+                times.push_back ( to_ms ( clock_type::now () - start ));
+                }
+            std::sort ( times.begin (), times.end ());
+            const double median_ms = percentile ( times, 50.0 );
+            if ( bc.calibrate && engine >= 0 ) {
+                const ba::pattern_profile p = ba::profile_pattern ( pattern.begin (), pattern.end ());
+                cell_ms_ [ tuning_.alphabet_class ( p ) ][ tuning_.length_class ( p.length ) ][ engine ] += median_ms;
+                }
+
+            out_ << ( first_ ? "\n" : ",\n" ) << "    { "
+                 << "\"searcher\": "       << json_string ( searcher_name )
+                 << ", \"corpus\": "       << json_string ( bc.corpus_name )
+                 << ", \"corpus_bytes\": " << corpus.size ()
+                 << ", \"pattern\": "      << json_string ( bc.pattern_name )
+                 << ", \"pattern_length\": " << pattern.size ()
+                 << ", \"matches\": "      << matches
+                 << ", \"reps\": "         << k_reps
+                 << ", \"median_gbps\": "  << ( median_ms > 0 ? corpus.size () / median_ms / 1e6 : 0.0 )
+                 << ", \"median_ms\": "    << median_ms
+                 << ", \"p99_ms\": "       << percentile ( times, 99.0 )
+                 << ", \"construct_ns\": " << construct_ns
+                 << " }";
+            first_ = false;
+            (void) sink;
+            }
+
+        void run_all ( const bench_case &bc ) {
+            run<ba::boyer_moore<vec_iter> >               ( "boyer_moore",               bc, ba::boyer_moore_engine );
+            run<ba::boyer_moore_horspool<vec_iter> >      ( "boyer_moore_horspool",      bc, ba::boyer_moore_horspool_engine );
+            run<ba::boyer_moore_horspool_simd<vec_iter> > ( "boyer_moore_horspool_simd", bc );
+            run<ba::boyer_moore_horspool_rare<vec_iter> > ( "boyer_moore_horspool_rare", bc );
+            run<ba::boyer_moore_horspool_qgram<vec_iter> > ( "boyer_moore_horspool_qgram", bc );
+            run<ba::knuth_morris_pratt<vec_iter> >        ( "knuth_morris_pratt",        bc, ba::knuth_morris_pratt_engine );
+            run<ba::two_way<vec_iter> >                   ( "two_way",                   bc, ba::two_way_engine );
+            run<ba::shift_or<vec_iter> >                  ( "shift_or",                  bc, ba::shift_or_engine );
+            run<std_searcher<vec_iter> >                  ( "std::search",               bc, ba::std_search_engine );
+            run<ba::adaptive_searcher<vec_iter> >         ( "make_searcher",             bc );
+            }
+
+    //  The default table, with each measured cell replaced by the fastest engine
+        ba::searcher_tuning calibrated () const {
+            ba::searcher_tuning retVal = tuning_;
+            for ( std::size_t a = 0; a < ba::searcher_tuning::k_alphabet_classes; ++a )
+                for ( std::size_t l = 0; l < ba::searcher_tuning::k_length_classes; ++l ) {
+                    const double *times = cell_ms_ [ a ][ l ];
+                    const double *best = std::min_element ( times, times + k_engines );
+                    if ( *best > 0.0 )
+                        retVal.engines [ a ][ l ] = static_cast<ba::searcher_engine> ( best - times );
+                    }
+            return retVal;
+            }
+
+    private:
+        BOOST_STATIC_CONSTANT ( std::size_t, k_engines = ba::shift_or_engine + 1 );
+
+        std::ostream &out_;
+        const unsigned k_reps;
+        bool first_;
+        const ba::searcher_tuning tuning_;
+    //  Total median time, by alphabet class, length class and engine
+        double cell_ms_ [ ba::searcher_tuning::k_alphabet_classes ][ ba::searcher_tuning::k_length_classes ][ k_engines ];
+        };
+    }
+
+
+int main ( int argc, char *argv [] ) {
+    bool quick = false;
+    unsigned reps = 11;
+    std::string data_dir = "../test/data-files";
+    std::string out_file;
+    std::string tuning_file;
+    for ( int i = 1; i < argc; ++i ) {
+        const std::string arg = argv [ i ];
+        if ( arg == "--quick" )
+            quick = true;
+        else if ( arg == "--reps" && i + 1 < argc )
+            reps = std::atoi ( argv [ ++i ] );
+        else if ( arg == "--data-dir" && i + 1 < argc )
+            data_dir = argv [ ++i ];
+        else if ( arg == "--out" && i + 1 < argc )
+            out_file = argv [ ++i ];
+        else if ( arg == "--tuning" && i + 1 < argc )
+            tuning_file = argv [ ++i ];
+        else {
+            std::cerr << "usage: " << argv [ 0 ] << " [--quick] [--reps N] [--data-dir DIR] [--out FILE] [--tuning FILE]" << std::endl;
+            return EXIT_FAILURE;
+            }
+        }
+    if ( quick )
+        reps = (std::min) ( reps, 5U );
+    if ( reps == 0 )
+        reps = 1;
+
+    std::ofstream file_out;
+    if ( !out_file.empty ()) {
+        file_out.open ( out_file.c_str ());
+        if ( !file_out ) {
+            std::cerr << "Can't open " << out_file << std::endl;
+            return EXIT_FAILURE;
+            }
+        }
+    std::ostream &out = out_file.empty () ? std::cout : file_out;
+    benchmark bench ( out, reps );
+
+    out << "{\n  \"benchmark\": \"boost.algorithm.searching\",\n  \"reps\": " << reps
+        << ",\n  \"results\": [";
+
+//  The generated corpora
+    const char *alphabets [] = { "binary", "dna", "english", "random" };
+    const std::size_t sizes [] = { 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 };
+    const std::size_t pattern_lengths [] = { 4, 16, 64, 256 };
+    const std::size_t num_sizes = quick ? 2 : sizeof ( sizes ) / sizeof ( sizes [ 0 ] );
+    for ( std::size_t a = 0; a < sizeof ( alphabets ) / sizeof ( alphabets [ 0 ] ); ++a )
+        for ( std::size_t sz = 0; sz < num_sizes; ++sz ) {
+            const vec corpus = make_corpus ( alphabets [ a ], sizes [ sz ], 12345 + a );
+            lcg gen ( 54321 + sz );
+            for ( std::size_t p = 0; p < sizeof ( pattern_lengths ) / sizeof ( pattern_lengths [ 0 ] ); ++p ) {
+            //  A pattern from the corpus, so that there is at least one match
+                const std::size_t len = pattern_lengths [ p ];
+                const std::size_t offset = gen () % ( corpus.size () - len );
+                std::ostringstream name;
+                name << "corpus@" << offset;
+
+                bench_case bc;
+                bc.corpus_name = alphabets [ a ];
+                bc.pattern_name = name.str ();
+                bc.corpus = &corpus;
+                bc.pattern.assign ( corpus.begin () + offset, corpus.begin () + offset + len );
+                bc.calibrate = true;
+                bench.run_all ( bc );
+                }
+            }
+
+//  The test data
+    const vec data_corpus = read_file ( data_dir + "/0001.corpus" );
+    const char *data_patterns [] = {
+        "0001b.pat", "0001e.pat", "0001f.pat", "0001n.pat",
+        "0002b.pat", "0002e.pat", "0002f.pat", "0002n.pat" };
+    for ( std::size_t i = 0; i < sizeof ( data_patterns ) / sizeof ( data_patterns [ 0 ] ); ++i ) {
+        bench_case bc;
+        bc.corpus_name = "0001.corpus";
+        bc.pattern_name = data_patterns [ i ];
+        bc.corpus = &data_corpus;
+        bc.pattern = read_file ( data_dir + "/" + data_patterns [ i ] );
+        bc.calibrate = false;
+        bench.run_all ( bc );
+        }
+
+    out << "\n  ]\n}" << std::endl;
+
+    if ( !tuning_file.empty ()) {
+        std::ofstream tuning_out ( tuning_file.c_str ());
+        if ( !( tuning_out << bench.calibrated ())) {
+            std::cerr << "Can't write " << tuning_file << std::endl;
+            return EXIT_FAILURE;
+            }
+        }
+    return 0;
+    }
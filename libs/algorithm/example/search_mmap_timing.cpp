@@ -0,0 +1,114 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <vector>
+
+#include <boost/chrono.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/mapped_corpus.hpp>
+
+namespace ba = boost::algorithm;
+typedef boost::chrono::steady_clock clock_type;
+typedef std::vector<char> vec;
+
+//  Compares searching a file that has been read into memory with searching
+//  the same file when it is memory mapped. Each timing includes getting
+//  the data into memory (read or mmap), and then searching all of it.
+//
+//  usage: search_mmap_timing [corpus-file [pattern [repetitions]]]
+//
+//  The first run warms the page cache, so later runs measure the cost of
+//  copying the data (read) against the cost of mapping it (mmap), rather than disk speed.
+
+namespace {
+
+    vec read_file ( const char *name ) {
+        std::ifstream in ( name, std::ios_base::binary | std::ios_base::in );
+        if ( !in ) {
+            std::cerr << "Can't open " << name << std::endl;
+            std::exit ( EXIT_FAILURE );
+            }
+        in.seekg ( 0, std::ios_base::end );
+        vec retVal ( static_cast<std::size_t> ( in.tellg ()));
+        in.seekg ( 0, std::ios_base::beg );
+        if ( !retVal.empty ())
+            in.read ( &retVal [ 0 ], retVal.size ());
+        return retVal;
+        }
+
+//  Count all the matches, so that the whole corpus gets searched
+    template <typename Searcher, typename Iter>
+    std::size_t count_matches ( const Searcher &s, Iter first, Iter last ) {
+        std::vector<Iter> matches;
+        s.find_all ( first, last, std::back_inserter ( matches ));
+        return matches.size ();
+        }
+
+    void print_rate ( const char *what, std::size_t bytes, unsigned reps, clock_type::duration d, std::size_t matches ) {
+        const double secs = boost::chrono::duration<double> ( d ).count ();
+        std::cout << std::setw ( 32 ) << what << "  "
+                  << std::setw ( 10 ) << std::fixed << std::setprecision ( 3 )
+                  << ( secs > 0 ? ( double ( bytes ) * reps ) / secs / 1e9 : 0.0 ) << " GB/s  ("
+                  << matches << " matches)" << std::endl;
+        }
+
+    template <typename Searcher>
+    void time_searcher ( const char *name, const char *file, const std::string &pattern, unsigned reps ) {
+        std::size_t bytes = 0, m1 = 0, m2 = 0;
+
+    //  Read the file into a vector, and search that
+        clock_type::time_point start = clock_type::now ();
+        for ( unsigned i = 0; i < reps; ++i ) {
+            const vec corpus = read_file ( file );
+            const Searcher s ( pattern.begin (), pattern.end ());
+            m1 = count_matches ( s, corpus.begin (), corpus.end ());
+            bytes = corpus.size ();
+            }
+        const clock_type::duration read_time = clock_type::now () - start;
+
+    //  Map the file, and search the mapping
+        start = clock_type::now ();
+        for ( unsigned i = 0; i < reps; ++i ) {
+            const ba::mapped_corpus corpus ( file );
+            const Searcher s ( pattern.begin (), pattern.end ());
+            m2 = count_matches ( s, corpus.begin (), corpus.end ());
+            }
+        const clock_type::duration mmap_time = clock_type::now () - start;
+
+        if ( m1 != m2 )
+            std::cerr << "Mismatch! " << name << " found " << m1 << " and " << m2 << " matches" << std::endl;
+        print_rate (( std::string ( name ) + " (read)" ).c_str (), bytes, reps, read_time, m1 );
+        print_rate (( std::string ( name ) + " (mmap)" ).c_str (), bytes, reps, mmap_time, m2 );
+        }
+    }
+
+
+int main ( int argc, char *argv [] ) {
+    const char *file = argc > 1 ? argv [ 1 ] : "../test/data-files/0001.corpus";
+    const std::string pattern = argc > 2 ? argv [ 2 ] : "Boost";
+    const unsigned reps = argc > 3 ? std::atoi ( argv [ 3 ] ) : 20;
+
+    std::cout << "Searching '" << file << "' for '" << pattern << "', "
+              << reps << " times" << std::endl;
+    (void) read_file ( file );  // warm up the page cache
+    typedef std::string::const_iterator pat_iter;
+    time_searcher<ba::boyer_moore<pat_iter> >          ( "boyer_moore",          file, pattern, reps );
+    time_searcher<ba::boyer_moore_horspool<pat_iter> > ( "boyer_moore_horspool", file, pattern, reps );
+    time_searcher<ba::knuth_morris_pratt<pat_iter> >   ( "knuth_morris_pratt",   file, pattern, reps );
+    return 0;
+    }
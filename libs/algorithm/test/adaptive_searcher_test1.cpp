@@ -0,0 +1,170 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/adaptive_searcher.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+
+//  A tuning table that always picks 'e'
+    ba::searcher_tuning force ( ba::searcher_engine e ) {
+        ba::searcher_tuning retVal;
+        retVal.periodic_engine = e;
+        for ( std::size_t a = 0; a < ba::searcher_tuning::k_alphabet_classes; ++a )
+            for ( std::size_t i = 0; i < ba::searcher_tuning::k_length_classes; ++i )
+                retVal.engines [ a ][ i ] = e;
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle, ba::searcher_engine e ) {
+        const str_iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        const ba::adaptive_searcher<str_iter> s ( needle.begin (), needle.end (), force ( e ));
+        BOOST_CHECK ( s.engine () == e );
+        BOOST_CHECK ( s ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( s ( haystack ) == exp );
+
+        if ( needle.empty ())
+            return;
+        std::vector<str_iter> all, found;
+        for ( str_iter it = haystack.begin (); ( it = std::search ( it, haystack.end (), needle.begin (), needle.end ())) != haystack.end (); ++it )
+            all.push_back ( it );
+        s.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( found ));
+        BOOST_CHECK ( found == all );
+
+    //  Non-overlapping matches
+        found.clear ();
+        s.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( found ), false );
+        all.clear ();
+        for ( str_iter it = haystack.begin (); std::distance ( it, haystack.end ()) >= (std::ptrdiff_t) needle.size () &&
+                    ( it = std::search ( it, haystack.end (), needle.begin (), needle.end ())) != haystack.end (); it += needle.size ())
+            all.push_back ( it );
+        BOOST_CHECK ( found == all );
+        }
+
+    void check_all_engines ( const std::string &haystack, const std::string &needle ) {
+        for ( int e = ba::std_search_engine; e <= ba::shift_or_engine; ++e )
+            check_one ( haystack, needle, static_cast<ba::searcher_engine> ( e ));
+        }
+
+    void test_choice () {
+        const ba::searcher_tuning t;
+
+        ba::pattern_profile p = ba::profile_pattern ( std::string ( "abcabcab" ));
+        BOOST_CHECK ( p.length == 8 && p.distinct == 3 && p.period == 3 );
+        p = ba::profile_pattern ( std::string ( "aaaa" ));
+        BOOST_CHECK ( p.length == 4 && p.distinct == 1 && p.period == 1 );
+        p = ba::profile_pattern ( std::string ());
+        BOOST_CHECK ( p.length == 0 && p.distinct == 0 && p.period == 0 );
+        std::vector<int> ints;
+        for ( int i = 0; i < 10; ++i )
+            ints.push_back ( i * 1000 % 7 );
+        p = ba::profile_pattern ( ints.begin (), ints.end ());
+        BOOST_CHECK ( p.length == 10 && p.distinct == 7 && p.period == 7 );
+
+    //  Short patterns use std::search
+        BOOST_CHECK ( ba::make_searcher ( std::string ( "abc" )).engine () == ba::std_search_engine );
+    //  Text
+        BOOST_CHECK ( ba::make_searcher ( std::string ( "pattern" )).engine () == t.engines [ 1 ][ 1 ] );
+        BOOST_CHECK ( ba::make_searcher ( std::string ( 100, 'x' ) + "yz" ).engine () == t.engines [ 0 ][ 3 ] );
+        BOOST_CHECK ( ba::make_searcher ( std::string ( "the quick brown fox jumps over the lazy dog, and then some more"
+                        " words to make it long" )).engine () == t.engines [ 1 ][ 3 ] );
+    //  DNA
+        BOOST_CHECK ( ba::make_searcher ( std::string ( "GATTACAGCTTAG" )).engine () == t.engines [ 0 ][ 1 ] );
+    //  Periodic
+        BOOST_CHECK ( ba::make_searcher ( std::string ( "abcabcabcabc" )).engine () == t.periodic_engine );
+
+    //  Turning off the periodic check
+        ba::searcher_tuning t2;
+        t2.periodic_divisor = 0;
+        BOOST_CHECK ( ba::make_searcher ( std::string ( "abcabcabcabc" ), t2 ).engine () == t2.engines [ 0 ][ 1 ] );
+
+    //  Iterators
+        const char *pat = "needle in a haystack";
+        BOOST_CHECK ( ba::make_searcher ( pat, pat + std::strlen ( pat )).engine () == t.engines [ 1 ][ 2 ] );
+        }
+
+    void test_tuning_io () {
+        ba::searcher_tuning t = force ( ba::knuth_morris_pratt_engine );
+        t.length_limit [ 0 ] = 3;
+        t.length_limit [ 1 ] = 12;
+        t.length_limit [ 2 ] = 200;
+        t.small_alphabet = 5;
+        t.periodic_divisor = 2;
+        t.engines [ 0 ][ 3 ] = ba::two_way_engine;
+        t.engines [ 1 ][ 0 ] = ba::boyer_moore_horspool_engine;
+
+        std::stringstream ss;
+        ss << t;
+        ba::searcher_tuning t2;
+        BOOST_CHECK ( ss >> t2 );
+        BOOST_CHECK ( t2.length_limit [ 0 ] == 3 && t2.length_limit [ 1 ] == 12 && t2.length_limit [ 2 ] == 200 );
+        BOOST_CHECK ( t2.small_alphabet == 5 && t2.periodic_divisor == 2 );
+        BOOST_CHECK ( t2.periodic_engine == ba::knuth_morris_pratt_engine );
+        for ( std::size_t a = 0; a < ba::searcher_tuning::k_alphabet_classes; ++a )
+            for ( std::size_t i = 0; i < ba::searcher_tuning::k_length_classes; ++i )
+                BOOST_CHECK ( t2.engines [ a ][ i ] == t.engines [ a ][ i ] );
+
+    //  Missing settings keep their values
+        std::istringstream partial ( "small_alphabet 9\n" );
+        ba::searcher_tuning t3;
+        BOOST_CHECK ( partial >> t3 );
+        BOOST_CHECK ( t3.small_alphabet == 9 && t3.periodic_engine == ba::searcher_tuning ().periodic_engine );
+
+    //  Bad input fails, and leaves the table alone
+        std::istringstream bad1 ( "periodic_engine quicksort\n" );
+        std::istringstream bad2 ( "small_alphabet 2\nno_such_setting 1\n" );
+        ba::searcher_tuning t4;
+        BOOST_CHECK ( !( bad1 >> t4 ));
+        BOOST_CHECK ( !( bad2 >> t4 ));
+        BOOST_CHECK ( t4.small_alphabet == ba::searcher_tuning ().small_alphabet );
+        BOOST_CHECK ( t4.periodic_engine == ba::searcher_tuning ().periodic_engine );
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    test_choice ();
+    test_tuning_io ();
+
+    check_all_engines ( "", "abc" );
+    check_all_engines ( "abc", "" );
+    check_all_engines ( "", "" );
+    check_all_engines ( "abababab", "abab" );
+    check_all_engines ( "Hello, World", "World" );
+    check_all_engines ( "Hello, World", "World!" );
+
+    std::string haystack;
+    for ( std::size_t i = 0; i < 4000; ++i )
+        haystack += "ACGT" [ std::rand () % 4 ];
+    for ( std::size_t len = 1; len < 300; len = len * 3 + 1 ) {
+        check_all_engines ( haystack, haystack.substr ( 3000, len ));
+        check_all_engines ( haystack, haystack.substr ( haystack.size () - len ));
+        }
+
+//  The chosen engine gives the same answer as std::search
+    for ( std::size_t len = 1; len < 300; len = len * 2 + 1 ) {
+        const std::string needle = haystack.substr ( 1234, len );
+        BOOST_CHECK ( ba::make_searcher ( needle ) ( haystack ) ==
+                        std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()));
+        }
+    return 0;
+}
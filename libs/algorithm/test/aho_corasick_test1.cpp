@@ -0,0 +1,139 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/aho_corasick.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  The reference implementation: look for each pattern separately with std::search
+    template <typename Container, typename Patterns>
+    std::vector<std::pair<std::size_t, std::size_t> >
+    naive_find_all ( const Container &haystack, const Patterns &needles ) {
+        std::vector<std::pair<std::size_t, std::size_t> > retVal;
+        for ( std::size_t i = 0; i < needles.size (); ++i ) {
+            typename Container::const_iterator it = haystack.begin ();
+            while (( it = std::search ( it, haystack.end (), needles[i].begin (), needles[i].end ())) != haystack.end ()) {
+                retVal.push_back ( std::make_pair ( i, (std::size_t) std::distance ( haystack.begin (), it )));
+                if ( needles[i].empty ()) break;
+                ++it;
+                }
+            }
+        std::sort ( retVal.begin (), retVal.end ());
+        return retVal;
+        }
+
+    template <typename Container, typename Patterns>
+    void check_one ( const Container &haystack, const Patterns &needles, std::size_t expected ) {
+        typedef typename Container::const_iterator iter_type;
+        typedef typename Container::value_type value_type;
+        typedef std::vector<std::pair<std::size_t, iter_type> > result_vec;
+
+        ba::aho_corasick<value_type> ac ( needles.begin (), needles.end ());
+        BOOST_CHECK_EQUAL ( ac.pattern_count (), needles.size ());
+
+        result_vec r1, r2;
+        ac.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( r1 ));
+        ba::aho_corasick_find_all ( haystack.begin (), haystack.end (), needles, std::back_inserter ( r2 ));
+
+    //  The automaton reports the matches ordered by where they end; sort them to compare
+        std::vector<std::pair<std::size_t, std::size_t> > got;
+        for ( typename result_vec::const_iterator it = r1.begin (); it != r1.end (); ++it )
+            got.push_back ( std::make_pair ( it->first, (std::size_t) std::distance ( haystack.begin (), it->second )));
+        std::sort ( got.begin (), got.end ());
+
+        const std::vector<std::pair<std::size_t, std::size_t> > exp = naive_find_all ( haystack, needles );
+        std::cout << "(Aho-Corasick) " << needles.size () << " patterns, haystack is " << haystack.size ()
+                  << " long; " << exp.size () << " matches" << std::endl;
+        BOOST_CHECK_EQUAL ( exp.size (), expected );
+        BOOST_CHECK ( got == exp );
+        BOOST_CHECK ( r1 == r2 );
+
+    //  The first match is the one that ends first
+        iter_type first = ac ( haystack.begin (), haystack.end ());
+        if ( r1.empty ())
+            BOOST_CHECK ( first == haystack.end ());
+        else
+            BOOST_CHECK ( first == r1.front ().second );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    std::vector<std::string> needles;
+    needles.push_back ( "he" );
+    needles.push_back ( "she" );
+    needles.push_back ( "his" );
+    needles.push_back ( "hers" );
+    check_one ( std::string ( "ushers" ), needles, 3 );
+    check_one ( std::string ( "ahishers" ), needles, 4 );
+    check_one ( std::string ( "" ), needles, 0 );
+    check_one ( std::string ( "xyzzy" ), needles, 0 );
+
+//  Duplicates, and patterns that are suffixes of other patterns
+    needles.push_back ( "he" );
+    needles.push_back ( "e" );
+    check_one ( std::string ( "ushers and hershey" ), needles, 13 );
+
+//  The empty pattern is found once, at the start
+    needles.push_back ( "" );
+    check_one ( std::string ( "ushers" ), needles, 6 );
+
+//  No patterns at all
+    check_one ( std::string ( "ushers" ), std::vector<std::string> (), 0 );
+
+//  Lots of overlapping patterns in a small alphabet
+    const std::string dna = make_corpus ( 2000, "ACGT", 4 );
+    std::vector<std::string> dna_needles;
+    for ( std::size_t i = 0; i < 200; ++i )
+        dna_needles.push_back ( dna.substr ( std::rand () % 1990, 1 + std::rand () % 8 ));
+    dna_needles.push_back ( "ACGTACGTACGTACGTACGT" );
+    check_one ( dna, dna_needles, naive_find_all ( dna, dna_needles ).size ());
+
+//  Patterns that use every byte value (each has a class of its own), and a corpus of
+//  bytes, some of which (the spaces) aren't in any pattern
+    std::vector<std::string> byte_needles;
+    for ( int c = 0; c < 256; c += 3 ) {
+        std::string pat ( 2, static_cast<char> ( c ));
+        pat [ 1 ] = static_cast<char> ( 255 - c );
+        byte_needles.push_back ( pat );
+        byte_needles.push_back ( std::string ( 1, static_cast<char> ( c + 1 )));
+        byte_needles.push_back ( std::string ( 1, static_cast<char> ( c + 2 )) + " " );
+        }
+    std::string bytes ( 5000, ' ' );
+    for ( std::size_t i = 0; i < bytes.size (); ++i )
+        if ( std::rand () % 4 != 0 )
+            bytes [ i ] = static_cast<char> ( std::rand () % 256 );
+    check_one ( bytes, byte_needles, naive_find_all ( bytes, byte_needles ).size ());
+
+//  Non-byte elements use the compressed transition table
+    const std::vector<int> iv ( dna.begin (), dna.end ());
+    std::vector<std::vector<int> > iv_needles;
+    for ( std::size_t i = 0; i < dna_needles.size (); ++i )
+        iv_needles.push_back ( std::vector<int> ( dna_needles[i].begin (), dna_needles[i].end ()));
+    check_one ( iv, iv_needles, naive_find_all ( dna, dna_needles ).size ());
+
+    ba::aho_corasick<char> ac = ba::make_aho_corasick ( needles );
+    BOOST_CHECK_EQUAL ( ac.pattern_count (), needles.size ());
+    return 0;
+    }
@@ -0,0 +1,146 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/batch_search.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdlib>
+#include <iterator>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+    const std::size_t npos = std::size_t ( -1 );
+
+    std::string make_record ( std::size_t len, const char *alphabet, std::size_t alpha_size ) {
+        std::string retVal ( len, ' ' );
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal [ i ] = alphabet [ std::rand () % alpha_size ];
+        return retVal;
+        }
+
+//  What searching each record on its own finds
+    std::vector<std::size_t> expected ( const std::vector<std::string> &records, const std::string &needle ) {
+        std::vector<std::size_t> retVal;
+        for ( std::size_t i = 0; i < records.size (); ++i ) {
+            const std::string &r = records [ i ];
+            const str_iter found = std::search ( r.begin (), r.end (), needle.begin (), needle.end ());
+            retVal.push_back ( r.empty () || found == r.end () ? npos : std::size_t ( found - r.begin ()));
+            }
+        return retVal;
+        }
+
+    template <typename Searcher>
+    void check_searcher ( const std::vector<std::string> &records, const std::string &arena,
+                const std::vector<std::size_t> &offsets, const std::string &needle,
+                const std::vector<std::size_t> &exp ) {
+        const ba::batch_searcher<str_iter, Searcher> bs ( needle.begin (), needle.end ());
+        std::vector<std::size_t> res;
+        bs.find_first ( records, std::back_inserter ( res ));
+        BOOST_CHECK ( res == exp );
+
+        res.clear ();
+        bs.find_first ( arena.begin (), offsets.begin (), offsets.end (), std::back_inserter ( res ));
+        BOOST_CHECK ( res == exp );
+
+        std::vector<bool> bits;
+        const std::size_t k_matches = exp.size () - std::count ( exp.begin (), exp.end (), npos );
+        BOOST_CHECK_EQUAL ( bs.match ( records, bits ), k_matches );
+        BOOST_REQUIRE_EQUAL ( bits.size (), exp.size ());
+        for ( std::size_t i = 0; i < exp.size (); ++i )
+            BOOST_CHECK_EQUAL ( bits [ i ], exp [ i ] != npos );
+
+        bits.assign ( 3, true );    // the old contents are discarded
+        BOOST_CHECK_EQUAL ( bs.match ( arena.begin (), offsets.begin (), offsets.end (), bits ), k_matches );
+        BOOST_REQUIRE_EQUAL ( bits.size (), exp.size ());
+        for ( std::size_t i = 0; i < exp.size (); ++i )
+            BOOST_CHECK_EQUAL ( bits [ i ], exp [ i ] != npos );
+        }
+
+    void check_one ( const std::vector<std::string> &records, const std::string &needle ) {
+        std::string arena;
+        std::vector<std::size_t> offsets ( 1, 0 );
+        for ( std::size_t i = 0; i < records.size (); ++i ) {
+            arena += records [ i ];
+            offsets.push_back ( arena.size ());
+            }
+        const std::vector<std::size_t> exp = expected ( records, needle );
+        check_searcher<ba::boyer_moore_horspool<str_iter> > ( records, arena, offsets, needle, exp );
+        check_searcher<ba::boyer_moore<str_iter> >          ( records, arena, offsets, needle, exp );
+        check_searcher<ba::knuth_morris_pratt<str_iter> >   ( records, arena, offsets, needle, exp );
+
+        std::vector<bool> bits;
+        ba::batch_match ( records, needle.begin (), needle.end (), bits );
+        BOOST_REQUIRE_EQUAL ( bits.size (), exp.size ());
+        for ( std::size_t i = 0; i < exp.size (); ++i )
+            BOOST_CHECK_EQUAL ( bits [ i ], exp [ i ] != npos );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    std::vector<std::string> records;
+    check_one ( records, "abc" );       // no records at all
+
+//  Matches that run from one record into the next don't count
+    records.push_back ( "xxab" );
+    records.push_back ( "cxx" );
+    records.push_back ( "" );
+    records.push_back ( "abc" );
+    records.push_back ( "ab" );
+    records.push_back ( "" );
+    records.push_back ( "c" );
+    records.push_back ( "zabcabc" );
+    check_one ( records, "abc" );
+    check_one ( records, "ab" );
+    check_one ( records, "c" );
+    check_one ( records, "" );
+    check_one ( records, "abcabcabc" );
+    check_one ( records, "bcx" );
+
+//  Lots of short records, in the 20 - 200 byte range, and some empty ones
+    records.clear ();
+    for ( std::size_t i = 0; i < 3000; ++i )
+        records.push_back ( make_record ( i % 50 == 0 ? 0 : 20 + std::rand () % 180, "abcd", 4 ));
+    check_one ( records, "abcd" );
+    check_one ( records, "dddd" );
+    check_one ( records, "aaaaaaaaaaaaaaaaaaaaaaaaa" );
+    check_one ( records, records [ 7 ].substr ( 10, 8 ));
+    check_one ( records, records [ 7 ] );
+    check_one ( records, records [ 7 ] + "a" );
+    check_one ( records, "x" );
+
+//  An arena with a prefix before the first record
+    {
+    const std::string arena ( "headerabcxyzab" );
+    std::vector<std::size_t> offsets;
+    offsets.push_back ( 6 );
+    offsets.push_back ( 9 );
+    offsets.push_back ( 12 );
+    offsets.push_back ( 14 );
+    const std::string needle ( "abc" );
+    const ba::batch_searcher<str_iter> bs ( needle.begin (), needle.end ());
+    std::vector<std::size_t> res;
+    bs.find_first ( arena.begin (), offsets.begin (), offsets.end (), std::back_inserter ( res ));
+    BOOST_REQUIRE_EQUAL ( res.size (), 3U );
+    BOOST_CHECK ( res [ 0 ] == 0 && res [ 1 ] == npos && res [ 2 ] == npos );
+    BOOST_CHECK ( ba::batch_searcher<str_iter>::npos == npos );
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore_horspool_qgram.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <iterator>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+
+    template <typename Searcher>
+    std::vector<std::ptrdiff_t> all_matches ( const Searcher &s, const std::string &haystack, bool overlapping ) {
+        std::vector<str_iter> res;
+        s.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( res ), overlapping );
+        std::vector<std::ptrdiff_t> retVal;
+        for ( std::size_t i = 0; i < res.size (); ++i )
+            retVal.push_back ( res [ i ] - haystack.begin ());
+        return retVal;
+        }
+
+    template <std::size_t Q>
+    void check_q ( const std::string &haystack, const std::string &needle ) {
+        typedef ba::boyer_moore_horspool_qgram<str_iter, ba::qgram_traits<str_iter, Q> > searcher;
+        const searcher s ( needle.begin (), needle.end ());
+        const ba::knuth_morris_pratt<str_iter> kmp ( needle.begin (), needle.end ());
+
+        const str_iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( s ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( s ( haystack ) == exp );
+        BOOST_CHECK ( all_matches ( s, haystack, true  ) == all_matches ( kmp, haystack, true  ));
+        BOOST_CHECK ( all_matches ( s, haystack, false ) == all_matches ( kmp, haystack, false ));
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        check_q<2> ( haystack, needle );
+        check_q<3> ( haystack, needle );
+        check_q<4> ( haystack, needle );
+        BOOST_CHECK ( ba::boyer_moore_horspool_qgram_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ())
+                        == std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()));
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, "ANPANMAN" );
+    check_one ( haystack1, "MAN THE" );
+    check_one ( haystack1, "WE\220ER" );
+    check_one ( haystack1, "NOW " );
+    check_one ( haystack1, "NEND" );
+    check_one ( haystack1, "NOT FOUND" );
+    check_one ( haystack1, "AN" );
+    check_one ( haystack1, "\220" );
+    check_one ( haystack1, "" );
+    check_one ( "", "abc" );
+    check_one ( "ab", "abc" );
+    check_one ( "abc", "abc" );
+    check_one ( haystack1, haystack1 );
+
+//  DNA; every pattern length from 1 to 60, including lots of repeats
+    const std::string dna = make_corpus ( 3000, "ACGT", 4 );
+    for ( std::size_t len = 1; len <= 60; ++len )
+        for ( std::size_t pos = 0; pos + len <= dna.size (); pos += 131 ) {
+            check_one ( dna, dna.substr ( pos, len ));
+            std::string pat = dna.substr ( pos, len );
+            pat [ len / 2 ] = 'N';
+            check_one ( dna, pat );
+            }
+    const std::string repeats = make_corpus ( 2000, "AC", 2 );
+    for ( std::size_t len = 1; len <= 30; ++len )
+        for ( std::size_t pos = 0; pos + len <= repeats.size (); pos += 173 )
+            check_one ( repeats, repeats.substr ( pos, len ));
+    check_one ( std::string ( 100, 'A' ), std::string ( 10, 'A' ));
+    check_one ( std::string ( 100, 'A' ), std::string ( 10, 'A' ) + "C" );
+
+//  Text; the q-grams collide in the hash
+    const std::string text = make_corpus ( 5000, "etaoin shrdluETAOIN", 19 );
+    for ( std::size_t len = 2; len <= 40; len += 3 )
+        for ( std::size_t pos = 0; pos + len <= text.size (); pos += 409 )
+            check_one ( text, text.substr ( pos, len ));
+
+//  A pattern whose shifts don't fit in the table
+    {
+    const std::string big = make_corpus ( 200000, "ACGT", 4 );
+    check_q<3> ( big, big.substr ( 50000, 70000 ));
+    check_q<4> ( big + big, big );
+    }
+
+//  Case-insensitive DNA
+    {
+    typedef ba::qgram_traits<str_iter, 4, ba::ascii_case_fold> fold_traits;
+    const std::string corpus = "acgtacgTTGCAacgtNNNN";
+    const std::string pat1 = "ttgcaACGT";
+    const std::string pat2 = "tTg";
+    ba::boyer_moore_horspool_qgram<str_iter, fold_traits> s1 ( pat1.begin (), pat1.end ());
+    ba::boyer_moore_horspool_qgram<str_iter, fold_traits> s2 ( pat2.begin (), pat2.end ());
+    BOOST_CHECK ( s1 ( corpus ) - corpus.begin () == 7 );
+    BOOST_CHECK ( s2 ( corpus ) - corpus.begin () == 7 );
+    }
+
+//  Wider elements
+    {
+    const int ipat [] = { 1000, 7, 2000, 7 };
+    std::vector<int> icorpus ( 50, 7 );
+    icorpus [ 20 ] = 1000; icorpus [ 22 ] = 2000;
+    BOOST_CHECK ( ba::boyer_moore_horspool_qgram_search ( icorpus.begin (), icorpus.end (), ipat, ipat + 4 )
+                    == icorpus.begin () + 20 );
+    }
+    return 0;
+}
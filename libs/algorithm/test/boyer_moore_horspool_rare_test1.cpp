@@ -0,0 +1,132 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore_horspool_rare.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    void check_one ( const std::string &haystack, const std::string &needle,
+                        const unsigned char *frequencies = ba::detail::default_byte_frequencies ()) {
+        const char *hBeg = haystack.data ();
+        const char *hEnd = hBeg + haystack.size ();
+        const char *nBeg = needle.data ();
+        const char *nEnd = nBeg + needle.size ();
+
+        const char *exp = std::search ( hBeg, hEnd, nBeg, nEnd );
+        ba::boyer_moore_horspool_rare<const char *> bmhr ( nBeg, nEnd, frequencies );
+        BOOST_CHECK ( bmhr ( hBeg, hEnd ) == exp );
+        BOOST_CHECK ( ba::boyer_moore_horspool_rare_search ( hBeg, hEnd, nBeg, nEnd ) == exp );
+
+    //  Non-pointer iterators go through boyer_moore_horspool
+        ba::boyer_moore_horspool_rare<std::string::const_iterator> bmhr_it ( needle.begin (), needle.end ());
+        BOOST_CHECK ( bmhr_it ( haystack.begin (), haystack.end ()) - haystack.begin () == exp - hBeg );
+
+    //  Unsigned bytes are searched the same way as chars
+        const unsigned char *uhBeg = reinterpret_cast<const unsigned char *> ( hBeg );
+        const unsigned char *unBeg = reinterpret_cast<const unsigned char *> ( nBeg );
+        BOOST_CHECK ( ba::boyer_moore_horspool_rare_search ( uhBeg, uhBeg + haystack.size (),
+                                        unBeg, unBeg + needle.size ()) - uhBeg == exp - hBeg );
+        }
+
+    std::size_t first_rare ( const std::string &needle, const unsigned char *frequencies ) {
+        ba::boyer_moore_horspool_rare<std::string::const_iterator> bmhr ( needle.begin (), needle.end (), frequencies );
+        return bmhr.rare_offsets ().first;
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, "ANPANMAN" );
+    check_one ( haystack1, "MAN THE" );
+    check_one ( haystack1, "WE\220ER" );
+    check_one ( haystack1, "NOW " );
+    check_one ( haystack1, "NEND" );
+    check_one ( haystack1, "NOT FOUND" );
+    check_one ( haystack1, "NOT FO\340ND" );
+    check_one ( haystack1, "\220" );
+    check_one ( haystack1, "Z" );
+    check_one ( haystack1, "" );
+    check_one ( "", "abc" );
+    check_one ( "ab", "abc" );
+    check_one ( haystack1, haystack1 );
+
+//  Choosing the rare bytes
+    {
+    const unsigned char *freq = ba::detail::default_byte_frequencies ();
+    BOOST_CHECK ( freq [ 'e' ] > freq [ 'q' ] && freq [ ' ' ] > freq [ 'Z' ] && freq [ 'z' ] > freq [ '\001' ] );
+    BOOST_CHECK_EQUAL ( first_rare ( "the quick", freq ), 4U );            // 'q'
+    BOOST_CHECK_EQUAL ( first_rare ( "zzz", freq ), 2U );                  // ties go to the last one
+
+    const std::string pat ( "xxqx" );
+    ba::boyer_moore_horspool_rare<std::string::const_iterator> bmhr ( pat.begin (), pat.end ());
+    BOOST_CHECK_EQUAL ( bmhr.rare_offsets ().first,  2 );                  // 'q'
+    BOOST_CHECK_EQUAL ( bmhr.rare_offsets ().second, 3 );                  // a different value from 'q'
+
+    const std::string same ( "aaaa" );
+    ba::boyer_moore_horspool_rare<std::string::const_iterator> bmhr2 ( same.begin (), same.end ());
+    BOOST_CHECK ( bmhr2.rare_offsets ().first != bmhr2.rare_offsets ().second );
+    }
+
+//  A frequency table built from the data; in a corpus of mostly 'q's, 'q' is common
+    {
+    const std::string sample = std::string ( 1000, 'q' ) + "the";
+    unsigned char freq [ 256 ];
+    ba::compute_byte_frequencies ( sample.begin (), sample.end (), freq );
+    BOOST_CHECK_EQUAL ( freq [ 'q' ], 255 );
+    BOOST_CHECK_EQUAL ( freq [ 'Q' ], 0 );
+    BOOST_CHECK ( freq [ 't' ] > 0 && freq [ 't' ] < freq [ 'q' ] );
+    BOOST_CHECK_EQUAL ( first_rare ( "the quick", freq ), 8U );            // 'k' isn't in the sample
+    BOOST_CHECK_EQUAL ( first_rare ( "qqqtqq", freq ), 3U );
+
+    check_one ( sample + sample, "qqqqqthe", freq );
+    check_one ( sample + sample, "theqqq", freq );
+    check_one ( sample + sample, "thequick", freq );
+    }
+
+//  Every pattern length from 1 to 40, at every offset in a corpus that straddles
+//  the vector and the scalar parts of the search.
+    const std::string dna = make_corpus ( 200, "ACGT", 4 );
+    for ( std::size_t len = 1; len <= 40; ++len )
+        for ( std::size_t pos = 0; pos + len <= dna.size (); pos += 7 )
+            check_one ( dna, dna.substr ( pos, len ));
+
+//  Text, where one of the bytes in the pattern is rare, and the rest are common
+    const std::string text = make_corpus ( 5000, "etaoin shrdlu", 13 );
+    for ( std::size_t len = 2; len <= 30; len += 3 )
+        for ( std::size_t pos = 0; pos + len <= text.size (); pos += 311 ) {
+            std::string pat = text.substr ( pos, len );
+            check_one ( text, pat );
+            pat [ len / 2 ] = 'z';
+            check_one ( text, pat );
+            check_one ( text.substr ( 0, pos ) + pat + text.substr ( pos ), pat );
+            }
+
+//  Wider elements go through boyer_moore_horspool
+    {
+    const int ipat [] = { 1000, 7, 2000 };
+    std::vector<int> icorpus ( 50, 7 );
+    icorpus [ 20 ] = 1000; icorpus [ 22 ] = 2000;
+    BOOST_CHECK ( ba::boyer_moore_horspool_rare_search ( &icorpus [ 0 ], &icorpus [ 0 ] + icorpus.size (), ipat, ipat + 3 )
+                    == &icorpus [ 20 ] );
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore_horspool_wildcard.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::vector<unsigned char>::const_iterator byte_iter;
+
+//  The reference implementation: try every position
+    std::vector<std::size_t> brute_find_all ( const std::vector<unsigned char> &haystack,
+                const std::vector<unsigned char> &needle, const std::vector<bool> &wild ) {
+        std::vector<std::size_t> retVal;
+        if ( haystack.empty ()) return retVal;
+        if ( needle.empty ()) { retVal.push_back ( 0 ); return retVal; }
+        for ( std::size_t i = 0; i + needle.size () <= haystack.size (); ++i ) {
+            std::size_t j = 0;
+            while ( j < needle.size () && ( wild [ j ] || needle [ j ] == haystack [ i + j ] ))
+                ++j;
+            if ( j == needle.size ())
+                retVal.push_back ( i );
+            }
+        return retVal;
+        }
+
+    void check_one ( const std::vector<unsigned char> &haystack,
+                const std::vector<unsigned char> &needle, const std::vector<bool> &wild ) {
+        const std::vector<std::size_t> exp = brute_find_all ( haystack, needle, wild );
+        ba::boyer_moore_horspool_wildcard<byte_iter> bmhw ( needle.begin (), needle.end (), wild.begin ());
+
+        std::vector<byte_iter> res;
+        bmhw.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( res ));
+        BOOST_REQUIRE_EQUAL ( res.size (), exp.size ());
+        for ( std::size_t i = 0; i < res.size (); ++i )
+            BOOST_CHECK_EQUAL ( std::size_t ( res [ i ] - haystack.begin ()), exp [ i ] );
+
+        const byte_iter first = bmhw ( haystack.begin (), haystack.end ());
+        BOOST_CHECK ( exp.empty () ? first == haystack.end () : first == haystack.begin () + exp [ 0 ] );
+        BOOST_CHECK ( first == ba::boyer_moore_horspool_wildcard_search (
+                        haystack.begin (), haystack.end (), needle.begin (), needle.end (), wild.begin ()));
+
+    //  Non-overlapping matches are the ones the brute force finds, skipping the overlaps
+        res.clear ();
+        bmhw.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( res ), false );
+        std::vector<std::size_t> exp_no;
+        for ( std::size_t i = 0; i < exp.size (); ++i )
+            if ( exp_no.empty () || exp [ i ] >= exp_no.back () + needle.size ())
+                exp_no.push_back ( exp [ i ] );
+        BOOST_REQUIRE_EQUAL ( res.size (), exp_no.size ());
+        for ( std::size_t i = 0; i < res.size (); ++i )
+            BOOST_CHECK_EQUAL ( std::size_t ( res [ i ] - haystack.begin ()), exp_no [ i ] );
+        }
+
+    void check_sig ( const std::vector<unsigned char> &haystack, const std::string &sig ) {
+        std::vector<unsigned char> needle;
+        std::vector<bool> wild;
+        ba::parse_signature ( sig, needle, wild );
+        check_one ( haystack, needle, wild );
+        }
+
+    std::vector<unsigned char> make_corpus ( std::size_t len, unsigned alpha_size ) {
+        std::vector<unsigned char> retVal;
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal.push_back ( static_cast<unsigned char> ( std::rand () % alpha_size ));
+        return retVal;
+        }
+    }
+
+int test_main( int , char* [] )
+{
+//  Parsing signatures
+    {
+    std::vector<unsigned char> pat;
+    std::vector<bool> wild;
+    ba::parse_signature ( "4D 5A ?? ?? 50 45", pat, wild );
+    BOOST_REQUIRE_EQUAL ( pat.size (), 6U );
+    BOOST_CHECK ( pat [ 0 ] == 0x4D && pat [ 1 ] == 0x5A && pat [ 4 ] == 0x50 && pat [ 5 ] == 0x45 );
+    BOOST_CHECK ( !wild [ 0 ] && !wild [ 1 ] && wild [ 2 ] && wild [ 3 ] && !wild [ 4 ] && !wild [ 5 ] );
+
+    ba::parse_signature ( "4d5a??\t??\n5045", pat, wild );
+    BOOST_CHECK_EQUAL ( pat.size (), 6U );
+    ba::parse_signature ( "  ", pat, wild );
+    BOOST_CHECK ( pat.empty () && wild.empty ());
+
+    BOOST_CHECK_THROW ( ba::parse_signature ( "4D 5", pat, wild ), ba::not_enough_input );
+    BOOST_CHECK_THROW ( ba::parse_signature ( "4D ?", pat, wild ), ba::not_enough_input );
+    BOOST_CHECK_THROW ( ba::parse_signature ( "4D 5G", pat, wild ), ba::non_hex_input );
+    BOOST_CHECK_THROW ( ba::parse_signature ( "4D ?5", pat, wild ), ba::non_hex_input );
+    }
+
+//  A PE header
+    {
+    std::vector<unsigned char> image ( 300, 0 );
+    image [ 100 ] = 0x4D; image [ 101 ] = 0x5A; image [ 102 ] = 0x90; image [ 104 ] = 0x50; image [ 105 ] = 0x45;
+    image [ 200 ] = 0x4D; image [ 201 ] = 0x5A; image [ 204 ] = 0x50; image [ 205 ] = 0x46;
+    std::vector<unsigned char> pat;
+    std::vector<bool> wild;
+    ba::parse_signature ( "4D 5A ?? ?? 50 45", pat, wild );
+    ba::boyer_moore_horspool_wildcard<byte_iter> bmhw ( pat.begin (), pat.end (), wild.begin ());
+    BOOST_CHECK ( bmhw ( image ) == image.begin () + 100 );
+    check_one ( image, pat, wild );
+    }
+
+    const std::vector<unsigned char> empty;
+    check_sig ( empty, "4D 5A" );
+    check_sig ( make_corpus ( 10, 4 ), "" );
+    check_sig ( make_corpus ( 10, 4 ), "?? ??" );                   // nothing fixed
+    check_sig ( make_corpus ( 10, 4 ), "?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ??" );
+    check_sig ( make_corpus ( 3, 4 ), "00 ?? 01 02" );              // longer than the corpus
+
+//  Random corpora and signatures; small alphabets, so there are lots of matches
+    const char *sigs [] = {
+        "00", "??", "00 01", "00 ??", "?? 00", "00 ?? 01", "?? 00 01 ??",
+        "01 ?? ?? 02 03 00 ?? 01", "00 01 02 ?? 03", "?? ?? 03 02 01 00 03 02 ?? 01",
+        "00 ?? 00 ?? 00 ?? 00 ?? 00", "03 03 03 03 ?? 03 03"
+        };
+    for ( unsigned alpha = 2; alpha <= 4; ++alpha ) {
+        const std::vector<unsigned char> haystack = make_corpus ( 5000, alpha );
+        for ( std::size_t i = 0; i < sizeof ( sigs ) / sizeof ( sigs [ 0 ] ); ++i )
+            check_sig ( haystack, sigs [ i ] );
+        }
+
+//  Signatures taken from the corpus, with random wildcards
+    const std::vector<unsigned char> haystack = make_corpus ( 20000, 256 );
+    for ( std::size_t i = 0; i < 100; ++i ) {
+        const std::size_t len = 1 + std::rand () % 40;
+        const std::size_t start = std::rand () % ( haystack.size () - len );
+        const std::vector<unsigned char> needle ( haystack.begin () + start, haystack.begin () + start + len );
+        std::vector<bool> wild ( len );
+        for ( std::size_t j = 0; j < len; ++j )
+            wild [ j ] = std::rand () % 4 == 0;
+        check_one ( haystack, needle, wild );
+        }
+
+//  Wider elements, and a plain bool array for the wildcards
+    {
+    const int ipat [] = { 1000, 7, -3, 2000 };
+    const bool iwild [] = { false, true, true, false };
+    std::vector<int> icorpus ( 50, 7 );
+    icorpus [ 20 ] = 1000; icorpus [ 23 ] = 2000;
+    icorpus [ 30 ] = 1000; icorpus [ 33 ] = 2001;
+    ba::boyer_moore_horspool_wildcard<const int *> bmhw ( ipat, ipat + 4, iwild );
+    BOOST_CHECK ( bmhw ( icorpus.begin (), icorpus.end ()) == icorpus.begin () + 20 );
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/mapped_corpus.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::vector<char> vec;
+
+//  Read the whole file, including whitespace
+    vec ReadFromFile ( const char *name ) {
+        std::ifstream in ( name, std::ios_base::binary | std::ios_base::in );
+        return vec ( std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char> ());
+        }
+
+//  Search the mapped file and the copy in memory; the results should agree
+    void check_one ( const ba::mapped_corpus &mc, const vec &haystack, const vec &needle ) {
+        typedef ba::mapped_corpus::const_iterator mc_iter;
+        const std::ptrdiff_t exp = std::search ( haystack.begin (), haystack.end (),
+                                        needle.begin (), needle.end ()) - haystack.begin ();
+
+        ba::boyer_moore<vec::const_iterator>          bm  ( needle.begin (), needle.end ());
+        ba::boyer_moore_horspool<vec::const_iterator> bmh ( needle.begin (), needle.end ());
+        ba::knuth_morris_pratt<vec::const_iterator>   kmp ( needle.begin (), needle.end ());
+
+        BOOST_CHECK_EQUAL ( bm  ( mc.begin (), mc.end ()) - mc.begin (), exp );
+        BOOST_CHECK_EQUAL ( bmh ( mc.begin (), mc.end ()) - mc.begin (), exp );
+        BOOST_CHECK_EQUAL ( kmp ( mc.begin (), mc.end ()) - mc.begin (), exp );
+
+        mc_iter res = ba::boyer_moore_search ( mc.begin (), mc.end (), needle.begin (), needle.end ());
+        BOOST_CHECK_EQUAL ( res - mc.begin (), exp );
+
+        std::vector<mc_iter> m1;
+        std::vector<vec::const_iterator> m2;
+        bmh.find_all ( mc.begin (), mc.end (), std::back_inserter ( m1 ));
+        bmh.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( m2 ));
+        BOOST_CHECK_EQUAL ( m1.size (), m2.size ());
+        for ( std::size_t i = 0; i < m1.size () && i < m2.size (); ++i )
+            BOOST_CHECK_EQUAL ( m1 [ i ] - mc.begin (), m2 [ i ] - haystack.begin ());
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const vec c1 = ReadFromFile ( "data-files/0001.corpus" );
+    ba::mapped_corpus mc ( "data-files/0001.corpus" );
+    BOOST_REQUIRE_EQUAL ( mc.size (), c1.size ());
+    BOOST_CHECK ( !mc.empty ());
+    BOOST_CHECK ( std::equal ( mc.begin (), mc.end (), c1.begin ()));
+
+    const char *patterns [] = {
+        "data-files/0001b.pat", "data-files/0001e.pat", "data-files/0001f.pat", "data-files/0001n.pat",
+        "data-files/0002b.pat", "data-files/0002e.pat", "data-files/0002f.pat", "data-files/0002n.pat" };
+    for ( std::size_t i = 0; i < sizeof ( patterns ) / sizeof ( patterns [ 0 ] ); ++i )
+        check_one ( mc, c1, ReadFromFile ( patterns [ i ] ));
+
+//  Some short patterns, which occur many times
+    const char *shorts [] = { "the", "e", " ", "\n", "Boost", "xyzzy" };
+    for ( std::size_t i = 0; i < sizeof ( shorts ) / sizeof ( shorts [ 0 ] ); ++i ) {
+        const vec needle ( shorts [ i ], shorts [ i ] + std::strlen ( shorts [ i ] ));
+        check_one ( mc, c1, needle );
+        }
+
+//  A different access pattern gives the same data
+    ba::mapped_corpus mc2 ( std::string ( "data-files/0001b.pat" ), ba::mapped_corpus::random_access );
+    const vec p1 = ReadFromFile ( "data-files/0001b.pat" );
+    BOOST_CHECK ( mc2.size () == p1.size () && std::equal ( mc2.begin (), mc2.end (), p1.begin ()));
+
+//  Files that can't be opened are reported
+    BOOST_CHECK_THROW ( ba::mapped_corpus ( "data-files/no-such-file" ), ba::mapped_corpus_error );
+    try {
+        ba::mapped_corpus mc3 ( "data-files/no-such-file" );
+        }
+    catch ( const ba::mapped_corpus_error &e ) {
+        const std::string *fn = boost::get_error_info<boost::errinfo_file_name> ( e );
+        BOOST_CHECK ( fn != NULL && *fn == "data-files/no-such-file" );
+        }
+
+    return 0;
+    }
@@ -0,0 +1,284 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/match_generator.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/shift_or.hpp>
+#include <boost/algorithm/searching/stream_search.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_ALGORITHM_SEARCH_COROUTINES
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+    typedef boost::uintmax_t position_type;
+
+    std::vector<std::ptrdiff_t> expected ( const std::string &haystack, const std::string &needle ) {
+        std::vector<str_iter> res;
+        ba::knuth_morris_pratt<str_iter> kmp ( needle.begin (), needle.end ());
+        kmp.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( res ), true );
+        std::vector<std::ptrdiff_t> retVal;
+        for ( std::size_t i = 0; i < res.size (); ++i )
+            retVal.push_back ( res [ i ] - haystack.begin ());
+        return retVal;
+        }
+
+    template <typename Searcher>
+    std::vector<std::ptrdiff_t> generated ( const std::string &haystack, const std::string &needle ) {
+        const Searcher s ( needle.begin (), needle.end ());
+        std::vector<std::ptrdiff_t> retVal;
+        for ( str_iter found : ba::matches ( s, haystack ))
+            retVal.push_back ( found - haystack.begin ());
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        const std::vector<std::ptrdiff_t> exp = expected ( haystack, needle );
+        BOOST_CHECK ( generated<ba::boyer_moore<str_iter> >          ( haystack, needle ) == exp );
+        BOOST_CHECK ( generated<ba::boyer_moore_horspool<str_iter> > ( haystack, needle ) == exp );
+        BOOST_CHECK ( generated<ba::knuth_morris_pratt<str_iter> >   ( haystack, needle ) == exp );
+        BOOST_CHECK ( generated<ba::shift_or<str_iter> >             ( haystack, needle ) == exp );
+        }
+
+//  The generator carries the searcher's state from one match to the next, so it
+//  compares no more elements than find_all does
+    template <typename Searcher>
+    void check_linear ( const std::string &haystack, const std::string &needle ) {
+        Searcher s ( needle.begin (), needle.end ());
+        std::vector<str_iter> all;
+        s.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ));
+        const boost::uintmax_t k_find_all = s.stats ().comparisons;
+
+        s.reset_stats ();
+        std::size_t count = 0;
+        for ( str_iter found : ba::matches ( s, haystack )) {
+            BOOST_CHECK ( count < all.size () && found == all [ count ] );
+            ++count;
+            }
+        BOOST_CHECK_EQUAL ( count, all.size ());
+        BOOST_CHECK_EQUAL ( s.stats ().comparisons, k_find_all );
+        BOOST_CHECK ( s.stats ().comparisons < 2 * haystack.size ());
+        }
+
+//  Counts the searches, to show that the generator is lazy
+    struct counting_searcher {
+        counting_searcher ( const std::string &pat ) : pat_ ( pat ), bmh_ ( pat_.begin (), pat_.end ()), calls_ ( 0 ) {}
+        str_iter operator () ( str_iter first, str_iter last ) const { ++calls_; return bmh_ ( first, last ); }
+        const std::string pat_;
+        ba::boyer_moore_horspool<str_iter> bmh_;
+        mutable int calls_;
+        };
+
+    struct throwing_searcher {
+        str_iter operator () ( str_iter first, str_iter last ) const {
+            if ( first != last && *first == '!' )
+                throw std::runtime_error ( "bang" );
+            return first;
+            }
+        };
+
+//  An asynchronous source of chunks. Each request for a chunk is queued on 'pending',
+//  and the chunk is delivered when the main loop resumes it, as an I/O completion would.
+    struct chunk_source {
+        chunk_source ( const std::vector<std::string> &chunks, std::deque<std::coroutine_handle<> > &pending, bool immediate )
+            : chunks_ ( chunks ), pending_ ( pending ), immediate_ ( immediate ), next_ ( 0 ), requests_ ( 0 ) {}
+
+        struct awaiter {
+            chunk_source &src;
+            bool await_ready () const { return src.immediate_; }
+            void await_suspend ( std::coroutine_handle<> h ) { src.pending_.push_back ( h ); }
+            std::string await_resume () {
+                ++src.requests_;
+                return src.next_ < src.chunks_.size () ? src.chunks_ [ src.next_++ ] : std::string ();
+                }
+            };
+        awaiter next () { return awaiter { *this }; }
+
+        const std::vector<std::string> &chunks_;
+        std::deque<std::coroutine_handle<> > &pending_;
+        bool immediate_;
+        std::size_t next_;
+        std::size_t requests_;
+        };
+
+//  A fire-and-forget coroutine, for the consumer
+    struct task {
+        struct promise_type {
+            task get_return_object () { return task (); }
+            std::suspend_never initial_suspend () noexcept { return {}; }
+            std::suspend_never final_suspend   () noexcept { return {}; }
+            void return_void () {}
+            void unhandled_exception () { std::terminate (); }
+            };
+        };
+
+    task consume ( ba::async_match_generator<position_type> &gen, std::vector<position_type> &out, bool &done ) {
+        while ( boost::optional<position_type> pos = co_await gen.next ())
+            out.push_back ( *pos );
+        done = true;
+        }
+
+    template <typename StreamSearcher>
+    void check_async ( const std::vector<std::string> &chunks, const std::string &needle, bool immediate ) {
+        std::string stream;
+        for ( std::size_t i = 0; i < chunks.size (); ++i )
+            stream += chunks [ i ];
+        const std::vector<std::ptrdiff_t> exp = expected ( stream, needle );
+
+        std::deque<std::coroutine_handle<> > pending;
+        chunk_source source ( chunks, pending, immediate );
+        StreamSearcher searcher ( needle.begin (), needle.end ());
+        ba::async_match_generator<position_type> gen = ba::async_matches ( searcher, source );
+
+        std::vector<position_type> res;
+        bool done = false;
+        consume ( gen, res, done );
+        std::size_t waits = 0;
+        while ( !pending.empty ()) {
+            BOOST_CHECK ( !done );
+            std::coroutine_handle<> h = pending.front ();
+            pending.pop_front ();
+            ++waits;
+            h.resume ();
+            }
+        BOOST_CHECK ( done );
+        BOOST_CHECK_EQUAL ( waits, immediate ? 0U : chunks.size () + 1 );
+        BOOST_CHECK_EQUAL ( source.requests_, chunks.size () + 1 );
+        BOOST_CHECK_EQUAL ( res.size (), exp.size ());
+        BOOST_CHECK ( std::equal ( res.begin (), res.end (), exp.begin ()));
+        }
+
+    void check_async_one ( const std::vector<std::string> &chunks, const std::string &needle ) {
+        check_async<ba::boyer_moore_horspool_stream<str_iter> > ( chunks, needle, false );
+        check_async<ba::boyer_moore_horspool_stream<str_iter> > ( chunks, needle, true );
+        check_async<ba::knuth_morris_pratt_stream<str_iter> >   ( chunks, needle, false );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, "ANPANMAN" );
+    check_one ( haystack1, "MAN THE" );
+    check_one ( haystack1, "NOT FOUND" );
+    check_one ( haystack1, "AN" );
+    check_one ( haystack1, "D" );
+    check_one ( "", "abc" );
+    check_one ( "ab", "abc" );
+    check_one ( std::string ( 50, 'a' ), "aaa" );
+
+    const std::string dna = make_corpus ( 2000, "AC", 2 );
+    for ( std::size_t len = 1; len <= 20; ++len )
+        for ( std::size_t pos = 0; pos + len <= dna.size (); pos += 197 )
+            check_one ( dna, dna.substr ( pos, len ));
+
+//  The empty pattern matches at every position
+    {
+    const std::string corpus ( "abc" ), empty;
+    BOOST_CHECK_EQUAL ( generated<ba::boyer_moore<str_iter> >          ( corpus, empty ).size (), 3U );
+    BOOST_CHECK_EQUAL ( generated<ba::boyer_moore_horspool<str_iter> > ( corpus, empty ).size (), 3U );
+    BOOST_CHECK_EQUAL ( generated<ba::knuth_morris_pratt<str_iter> >   ( corpus, empty ).size (), 3U );
+    BOOST_CHECK_EQUAL ( generated<ba::shift_or<str_iter> >             ( corpus, empty ).size (), 3U );
+    BOOST_CHECK ( generated<ba::boyer_moore<str_iter> >      ( empty, empty ).empty ());
+    BOOST_CHECK ( generated<ba::knuth_morris_pratt<str_iter> > ( empty, empty ).empty ());
+    }
+
+//  Heavily overlapping matches are found in linear time
+    {
+    const std::string run ( 10000, 'a' );
+    check_linear<ba::knuth_morris_pratt<str_iter, ba::counting_search_stats> > ( run, "aaa" );
+    check_linear<ba::boyer_moore<str_iter, ba::folding_traits<str_iter>, ba::counting_search_stats> > ( run, "aaa" );
+    check_linear<ba::knuth_morris_pratt<str_iter, ba::counting_search_stats> > ( dna, "ACA" );
+    check_linear<ba::boyer_moore<str_iter, ba::folding_traits<str_iter>, ba::counting_search_stats> > ( dna, "ACA" );
+    }
+
+//  The search only runs as far as the matches that are asked for
+    {
+    const std::string corpus ( "xxAxxAxxAxxA" );
+    const counting_searcher s ( "A" );
+    ba::match_generator<str_iter> gen = ba::matches ( s, corpus.begin (), corpus.end ());
+    BOOST_CHECK_EQUAL ( s.calls_, 0 );
+    ba::match_generator<str_iter>::iterator it = gen.begin ();
+    BOOST_CHECK_EQUAL ( s.calls_, 1 );
+    BOOST_CHECK ( *it == corpus.begin () + 2 );
+    ++it;
+    BOOST_CHECK_EQUAL ( s.calls_, 2 );
+    BOOST_CHECK ( *it == corpus.begin () + 5 );
+
+    ba::match_generator<str_iter> moved ( std::move ( gen ));
+    ++it;
+    BOOST_CHECK ( *it == corpus.begin () + 8 );
+    ++it;
+    ++it;
+    BOOST_CHECK ( it == moved.end ());
+    BOOST_CHECK_EQUAL ( s.calls_, 4 );      // the last match is at the end of the corpus
+    }
+
+//  Exceptions from the searcher come out of the generator
+    {
+    const std::string corpus ( "ab!c" );
+    const throwing_searcher s;
+    std::string seen;
+    bool threw = false;
+    try {
+        for ( str_iter found : ba::matches ( s, corpus ))
+            seen += *found;
+        }
+    catch ( const std::runtime_error & ) { threw = true; }
+    BOOST_CHECK ( threw );
+    BOOST_CHECK_EQUAL ( seen, "ab" );
+    }
+
+//  Chunks from an asynchronous source, with matches that straddle the chunks
+    {
+    std::vector<std::string> chunks;
+    check_async_one ( chunks, "abc" );
+    chunks.push_back ( "xxab" );
+    chunks.push_back ( "cxxa" );
+    chunks.push_back ( "b" );
+    chunks.push_back ( "cabcab" );
+    chunks.push_back ( "c" );
+    check_async_one ( chunks, "abc" );
+    check_async_one ( chunks, "bcab" );
+    check_async_one ( chunks, "x" );
+    check_async_one ( chunks, "zzz" );
+
+    chunks.clear ();
+    for ( std::size_t pos = 0; pos < dna.size (); pos += 37 )
+        chunks.push_back ( dna.substr ( pos, 37 ));
+    for ( std::size_t len = 1; len <= 60; len += 7 )
+        check_async_one ( chunks, dna.substr ( 500, len ));
+    }
+    return 0;
+}
+
+#else
+
+int test_main( int , char* [] )
+{
+    return 0;
+}
+
+#endif
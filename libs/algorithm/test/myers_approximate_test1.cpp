@@ -0,0 +1,139 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/myers_approximate.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+    typedef ba::approximate_match<str_iter> match;
+
+//  The reference implementation: the dynamic programming table, one column at a time
+    std::vector<match> dp_find_all ( const std::string &haystack, const std::string &needle, std::size_t k ) {
+        std::vector<match> retVal;
+        if ( needle.empty ()) {     // like the exact searchers, the empty pattern matches once, at the start
+            if ( !haystack.empty ())
+                retVal.push_back ( match ( haystack.begin (), 0 ));
+            return retVal;
+            }
+
+        const std::size_t m = needle.size ();
+        std::vector<std::size_t> col ( m + 1 ), next ( m + 1 );
+        for ( std::size_t i = 0; i <= m; ++i )
+            col [ i ] = i;
+        for ( std::size_t j = 0; j < haystack.size (); ++j ) {
+            next [ 0 ] = 0;
+            for ( std::size_t i = 1; i <= m; ++i )
+                next [ i ] = (std::min) ( (std::min) ( col [ i ] + 1, next [ i - 1 ] + 1 ),
+                                          col [ i - 1 ] + ( needle [ i - 1 ] == haystack [ j ] ? 0 : 1 ));
+            col.swap ( next );
+            if ( col [ m ] <= k )
+                retVal.push_back ( match ( haystack.begin () + j + 1, col [ m ] ));
+            }
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle, std::size_t k ) {
+        const std::vector<match> exp = dp_find_all ( haystack, needle, k );
+        std::vector<match> res;
+        ba::myers_approximate<str_iter> ma ( needle.begin (), needle.end (), k );
+        ma.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( res ));
+        BOOST_CHECK ( res == exp );
+
+        const boost::optional<match> first = ma ( haystack.begin (), haystack.end ());
+        BOOST_CHECK ( first ? !exp.empty () && *first == exp [ 0 ] : exp.empty ());
+
+        res.clear ();
+        ba::myers_approximate_find_all ( haystack.begin (), haystack.end (),
+                        needle.begin (), needle.end (), k, std::back_inserter ( res ));
+        BOOST_CHECK ( res == exp );
+        }
+
+//  Introduce 'edits' random edits into 's'
+    std::string mutate ( std::string s, std::size_t edits ) {
+        for ( std::size_t i = 0; i < edits && !s.empty (); ++i ) {
+            const std::size_t pos = std::rand () % s.size ();
+            switch ( std::rand () % 3 ) {
+                case 0:  s [ pos ] = 'x'; break;
+                case 1:  s.erase ( pos, 1 ); break;
+                default: s.insert ( pos, 1, 'y' ); break;
+                }
+            }
+        return s;
+        }
+    }
+
+int test_main( int , char* [] )
+{
+//  Simple cases
+    {
+    const std::string haystack ( "the quick brown fox jumps over the lazy dog" );
+    std::vector<match> res;
+    const std::string pat ( "qiuck" );
+    ba::myers_approximate<str_iter> ma2 ( pat.begin (), pat.end (), 2 );
+    ma2.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( res ));
+    BOOST_REQUIRE ( !res.empty ());
+    BOOST_CHECK ( res [ 0 ].last - haystack.begin () <= 10 );
+    BOOST_CHECK ( !ba::myers_approximate<str_iter> ( pat.begin (), pat.end (), 1 ) ( haystack ));
+    BOOST_CHECK ( ma2.max_distance () == 2 );
+    }
+
+    check_one ( "", "abc", 1 );
+    check_one ( "abc", "", 1 );
+    check_one ( "abc", "abc", 0 );
+    check_one ( "abc", "abc", 5 );
+    check_one ( "abxc", "abc", 1 );
+    check_one ( "ac", "abc", 1 );
+
+//  Random DNA, with patterns that are (about) in the corpus, and random ones.
+//  The lengths cover one block, exactly one block, and several blocks.
+    const std::string haystack = make_corpus ( 3000, "ACGT", 4 );
+    const std::size_t lengths [] = { 1, 2, 5, 17, 63, 64, 65, 100, 128, 129, 200 };
+    for ( std::size_t l = 0; l < sizeof ( lengths ) / sizeof ( lengths [ 0 ] ); ++l ) {
+        const std::size_t len = lengths [ l ];
+        for ( std::size_t k = 0; k <= 8; k += 2 ) {
+            check_one ( haystack, haystack.substr ( 1500, len ), k );
+            check_one ( haystack, mutate ( haystack.substr ( 2000, len ), k / 2 + 1 ), k );
+            check_one ( haystack, make_corpus ( len, "ACGT", 4 ), k + len / 3 );
+            }
+        }
+
+//  Forward iterators for the corpus, and a wider element type
+    std::list<int> lcorpus;
+    std::vector<int> vpat;
+    for ( int i = 0; i < 500; ++i )
+        lcorpus.push_back ( i * 7919 % 1000 );
+    for ( int i = 200; i < 280; ++i )
+        vpat.push_back ( i * 7919 % 1000 );
+    vpat [ 10 ] = -1;
+    vpat.erase ( vpat.begin () + 40 );
+    ba::myers_approximate<std::vector<int>::const_iterator> mi ( vpat.begin (), vpat.end (), 2 );
+    std::vector<ba::approximate_match<std::list<int>::const_iterator> > lres;
+    const std::list<int> &clcorpus = lcorpus;
+    mi.find_all ( clcorpus.begin (), clcorpus.end (), std::back_inserter ( lres ));
+    BOOST_REQUIRE ( lres.size () >= 1 );
+    std::size_t best = 100;
+    for ( std::size_t i = 0; i < lres.size (); ++i )
+        best = (std::min) ( best, lres [ i ].distance );
+    BOOST_CHECK_EQUAL ( best, 2U );
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/parallel_search.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+
+    template <typename Searcher>
+    void check_searcher ( const Searcher &s, const std::string &haystack, const std::string &needle,
+                            std::size_t threads, std::size_t chunk ) {
+        const str_iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( ba::parallel_search ( s, haystack.begin (), haystack.end (), needle.size (), threads, chunk ) == exp );
+
+        std::vector<str_iter> all, par;
+        s.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ));
+        ba::parallel_find_all ( s, haystack.begin (), haystack.end (), needle.size (),
+                                    std::back_inserter ( par ), threads, chunk );
+        BOOST_CHECK ( all == par );
+        }
+
+//  The same searches with a pool of our own, which is used again and again
+    template <typename Searcher>
+    void check_pool ( ba::search_thread_pool &pool, const Searcher &s, const std::string &haystack,
+                            const std::string &needle, std::size_t chunk ) {
+        const str_iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( ba::parallel_search ( pool, s, haystack.begin (), haystack.end (), needle.size (), chunk ) == exp );
+
+        std::vector<str_iter> all, par;
+        s.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ));
+        ba::parallel_find_all ( pool, s, haystack.begin (), haystack.end (), needle.size (),
+                                    std::back_inserter ( par ), chunk );
+        BOOST_CHECK ( all == par );
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        ba::boyer_moore<str_iter>          bm  ( needle.begin (), needle.end ());
+        ba::boyer_moore_horspool<str_iter> bmh ( needle.begin (), needle.end ());
+        ba::knuth_morris_pratt<str_iter>   kmp ( needle.begin (), needle.end ());
+
+        const std::size_t threads [] = { 1, 2, 4, 0 };
+        const std::size_t chunks  [] = { 1, 3, 7, 100, 0 };
+        for ( std::size_t t = 0; t < sizeof ( threads ) / sizeof ( threads [ 0 ] ); ++t )
+            for ( std::size_t c = 0; c < sizeof ( chunks ) / sizeof ( chunks [ 0 ] ); ++c ) {
+                check_searcher ( bm,  haystack, needle, threads [ t ], chunks [ c ] );
+                check_searcher ( bmh, haystack, needle, threads [ t ], chunks [ c ] );
+                check_searcher ( kmp, haystack, needle, threads [ t ], chunks [ c ] );
+                }
+
+        static ba::search_thread_pool pool ( 3 );
+        for ( std::size_t c = 0; c < sizeof ( chunks ) / sizeof ( chunks [ 0 ] ); ++c ) {
+            check_pool ( pool, bm,  haystack, needle, chunks [ c ] );
+            check_pool ( pool, kmp, haystack, needle, chunks [ c ] );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, "ANPANMAN" );
+    check_one ( haystack1, "MAN THE" );
+    check_one ( haystack1, "NOW " );
+    check_one ( haystack1, "NEND" );
+    check_one ( haystack1, "NOT FOUND" );
+    check_one ( haystack1, "AN" );
+    check_one ( haystack1, haystack1 );
+    check_one ( haystack1, "" );
+    check_one ( "", "abc" );
+    check_one ( std::string ( 100, 'a' ), "aaa" );
+
+//  A bigger corpus, with the match near the end, so that most chunks miss
+    std::string big = make_corpus ( 300000, "abc", 3 );
+    check_one ( big, "abcabcabcabcabcab" );
+    big.replace ( big.size () - 1000, 10, "XYZZYXYZZY" );
+    check_one ( big, "XYZZYXYZZY" );
+    check_one ( big, big.substr ( 1234, 50 ));
+
+//  The wrong pattern length
+    const std::string needle ( "XYZZYXYZZY" );
+    ba::boyer_moore<str_iter> bm ( needle.begin (), needle.end ());
+    std::vector<str_iter> found;
+    BOOST_CHECK_THROW ( ba::parallel_search ( bm, big.begin (), big.end (), needle.size () - 5, 2 ), ba::parallel_search_error );
+    BOOST_CHECK_THROW ( ba::parallel_search ( bm, big.begin (), big.end (), needle.size () + 2, 2 ), ba::parallel_search_error );
+    BOOST_CHECK_THROW ( ba::parallel_find_all ( bm, big.begin (), big.end (), needle.size () - 1,
+                                                std::back_inserter ( found ), 2 ), ba::parallel_search_error );
+
+//  A pool carries on after a failed search
+    ba::search_thread_pool pool ( 2 );
+    BOOST_CHECK_EQUAL ( pool.size (), 2U );
+    BOOST_CHECK_THROW ( ba::parallel_search ( pool, bm, big.begin (), big.end (), needle.size () - 1, 1000 ), ba::parallel_search_error );
+    BOOST_CHECK ( ba::parallel_search ( pool, bm, big.begin (), big.end (), needle.size (), 1000 ) == big.end () - 1000 );
+    return 0;
+    }
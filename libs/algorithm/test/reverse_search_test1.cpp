@@ -0,0 +1,98 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/reverse_search.hpp>
+
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        const str_iter exp = std::find_end ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+
+        const ba::reverse_boyer_moore<str_iter>          bm  ( needle.begin (), needle.end ());
+        const ba::reverse_boyer_moore_horspool<str_iter> bmh ( needle.begin (), needle.end ());
+        BOOST_CHECK ( bm  ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( bmh ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( bm  ( haystack ) == exp );
+        BOOST_CHECK ( bmh ( haystack ) == exp );
+        BOOST_CHECK ( ba::reverse_boyer_moore_search          ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == exp );
+        BOOST_CHECK ( ba::reverse_boyer_moore_horspool_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == exp );
+
+    //  A bidirectional corpus
+        const std::list<char> hl ( haystack.begin (), haystack.end ());
+        const std::list<char>::const_iterator lexp = std::find_end ( hl.begin (), hl.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( bm  ( hl.begin (), hl.end ()) == lexp );
+        BOOST_CHECK ( bmh ( hl.begin (), hl.end ()) == lexp );
+        }
+
+//  Count the number of times that the corpus is read
+    std::size_t reads = 0;
+    struct count_reads {
+        typedef char result_type;
+        char operator () ( char c ) const { ++reads; return c; }
+        };
+    typedef boost::transform_iterator<count_reads, str_iter> counting_iter;
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, "ANPANMAN" );
+    check_one ( haystack1, "MAN THE" );
+    check_one ( haystack1, "NOW " );
+    check_one ( haystack1, "NEND" );
+    check_one ( haystack1, "NOT FOUND" );
+    check_one ( haystack1, "AN" );
+    check_one ( haystack1, "N" );
+    check_one ( haystack1, haystack1 );
+    check_one ( haystack1, "" );
+    check_one ( "", "abc" );
+    check_one ( "", "" );
+    check_one ( "abc", haystack1 );
+    check_one ( std::string ( 50, 'a' ), "aaa" );
+    check_one ( "abababababababab", "abab" );
+
+    const std::string binary = make_corpus ( 2000, "ab", 2 );
+    for ( std::size_t len = 1; len <= 16; ++len )
+        for ( std::size_t i = 0; i < 10; ++i ) {
+            check_one ( binary, random_substr ( binary, len ));
+            check_one ( binary, make_corpus ( len, "ab", 2 ));
+            }
+
+//  Finding a match near the end of a big corpus only looks at the end of it
+    std::string log ( 1000000, 'x' );
+    for ( std::size_t i = 0; i < log.size (); i += 100 )
+        log [ i ] = '\n';
+    const std::string sep ( "\n--\n" );
+    log.replace ( 100, sep.size (), sep );
+    log.replace ( log.size () - 5000, sep.size (), sep );
+
+    const ba::reverse_boyer_moore<str_iter> bm ( sep.begin (), sep.end ());
+    reads = 0;
+    const counting_iter res = bm ( counting_iter ( log.begin ()), counting_iter ( log.end ()));
+    BOOST_CHECK ( res.base () == log.end () - 5000 );
+    BOOST_CHECK_LE ( reads, 2 * 5000U );
+    return 0;
+    }
@@ -0,0 +1,88 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore_horspool_simd.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        const char *hBeg = haystack.data ();
+        const char *hEnd = hBeg + haystack.size ();
+        const char *nBeg = needle.data ();
+        const char *nEnd = nBeg + needle.size ();
+
+        const char *exp = std::search ( hBeg, hEnd, nBeg, nEnd );
+        ba::boyer_moore_horspool_simd<const char *> bmhs ( nBeg, nEnd );
+        BOOST_CHECK ( bmhs ( hBeg, hEnd ) == exp );
+        BOOST_CHECK ( ba::boyer_moore_horspool_simd_search ( hBeg, hEnd, nBeg, nEnd ) == exp );
+
+    //  Non-pointer iterators go through boyer_moore_horspool
+        ba::boyer_moore_horspool_simd<std::string::const_iterator> bmhs_it ( needle.begin (), needle.end ());
+        BOOST_CHECK ( bmhs_it ( haystack.begin (), haystack.end ()) - haystack.begin () == exp - hBeg );
+
+    //  Unsigned bytes (through pointers) take the vectorized path too
+        const unsigned char *uhBeg = reinterpret_cast<const unsigned char *> ( hBeg );
+        const unsigned char *unBeg = reinterpret_cast<const unsigned char *> ( nBeg );
+        BOOST_CHECK ( ba::boyer_moore_horspool_simd_search ( uhBeg, uhBeg + haystack.size (),
+                                        unBeg, unBeg + needle.size ()) - uhBeg == exp - hBeg );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, "ANPANMAN" );
+    check_one ( haystack1, "MAN THE" );
+    check_one ( haystack1, "WE\220ER" );
+    check_one ( haystack1, "NOW " );
+    check_one ( haystack1, "NEND" );
+    check_one ( haystack1, "NOT FOUND" );
+    check_one ( haystack1, "NOT FO\340ND" );
+    check_one ( haystack1, "\220" );
+    check_one ( haystack1, "Z" );
+    check_one ( haystack1, "" );
+    check_one ( "", "abc" );
+    check_one ( "ab", "abc" );
+    check_one ( haystack1, haystack1 );
+
+//  Every pattern length from 1 to 40, at every offset in a corpus that straddles
+//  the vector and the scalar parts of the search.
+    const std::string dna = make_corpus ( 200, "ACGT", 4 );
+    for ( std::size_t len = 1; len <= 40; ++len )
+        for ( std::size_t pos = 0; pos + len <= dna.size (); pos += 7 )
+            check_one ( dna, dna.substr ( pos, len ));
+
+//  Patterns whose first and last elements match often, but whose interior doesn't
+    const std::string binary = make_corpus ( 5000, "ab", 2 );
+    for ( std::size_t len = 2; len <= 20; ++len ) {
+        check_one ( binary, "a" + std::string ( len - 2, 'b' ) + "a" );
+        check_one ( binary, std::string ( len, 'a' ));
+        check_one ( binary, binary.substr ( binary.size () - len ));
+        }
+
+//  Wide characters use boyer_moore_horspool
+    const std::vector<int> iv ( dna.begin (), dna.end ());
+    const std::vector<int> ip ( dna.begin () + 150, dna.begin () + 160 );
+    BOOST_CHECK ( ba::boyer_moore_horspool_simd_search ( iv.begin (), iv.end (), ip.begin (), ip.end ())
+                == std::search ( iv.begin (), iv.end (), ip.begin (), ip.end ()));
+    return 0;
+    }
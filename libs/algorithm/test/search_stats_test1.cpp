@@ -0,0 +1,156 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+
+    typedef ba::boyer_moore<str_iter, ba::folding_traits<str_iter>, ba::counting_search_stats> counting_bm;
+    typedef ba::boyer_moore_horspool<str_iter, ba::folding_traits<str_iter>, ba::counting_search_stats> counting_bmh;
+    typedef ba::knuth_morris_pratt<str_iter, ba::counting_search_stats> counting_kmp;
+
+    template <typename Searcher>
+    std::vector<std::ptrdiff_t> all_matches ( const Searcher &s, const std::string &haystack, bool overlapping ) {
+        std::vector<str_iter> res;
+        s.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( res ), overlapping );
+        std::vector<std::ptrdiff_t> retVal;
+        for ( std::size_t i = 0; i < res.size (); ++i )
+            retVal.push_back ( res [ i ] - haystack.begin ());
+        return retVal;
+        }
+
+//  Counts that hold for any search
+    void check_counts ( const ba::search_stats &st, std::size_t corpus_length, std::size_t pattern_length ) {
+        BOOST_CHECK ( st.comparisons >= st.verifications );
+        BOOST_CHECK ( st.max_verification <= pattern_length );
+        BOOST_CHECK ( st.max_shift <= pattern_length );
+        BOOST_CHECK ( st.total_shift <= corpus_length + pattern_length );
+        BOOST_CHECK ( st.verifications <= corpus_length );
+        }
+
+//  The counting searchers find what the plain ones do
+    template <typename Plain, typename Counting>
+    void check_searcher ( const std::string &haystack, const std::string &needle ) {
+        const Plain p ( needle.begin (), needle.end ());
+        Counting c ( needle.begin (), needle.end ());
+        BOOST_CHECK ( p ( haystack.begin (), haystack.end ()) == c ( haystack.begin (), haystack.end ()));
+        check_counts ( c.stats (), haystack.size (), needle.size ());
+        c.reset_stats ();
+        BOOST_CHECK ( all_matches ( p, haystack, true  ) == all_matches ( c, haystack, true  ));
+        BOOST_CHECK ( all_matches ( p, haystack, false ) == all_matches ( c, haystack, false ));
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        check_searcher<ba::boyer_moore<str_iter>,          counting_bm>  ( haystack, needle );
+        check_searcher<ba::boyer_moore_horspool<str_iter>, counting_bmh> ( haystack, needle );
+        check_searcher<ba::knuth_morris_pratt<str_iter>,   counting_kmp> ( haystack, needle );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+//  None of the pattern is in the corpus; every window is a one element mismatch and a full shift
+    {
+    const std::string corpus ( 9, 'x' );
+    const std::string pat ( "abc" );
+    counting_bmh bmh ( pat.begin (), pat.end ());
+    BOOST_CHECK ( bmh ( corpus.begin (), corpus.end ()) == corpus.end ());
+    const ba::search_stats &st = bmh.stats ();
+    BOOST_CHECK_EQUAL ( st.verifications, 3U );
+    BOOST_CHECK_EQUAL ( st.comparisons, 3U );
+    BOOST_CHECK_EQUAL ( st.max_verification, 1U );
+    BOOST_CHECK_EQUAL ( st.lookups, 3U );
+    BOOST_CHECK_EQUAL ( st.shifts, 3U );
+    BOOST_CHECK_EQUAL ( st.max_shift, 3U );
+    BOOST_CHECK_EQUAL ( st.average_shift (), 3.0 );
+    BOOST_CHECK_EQUAL ( st.average_verification (), 1.0 );
+
+    counting_bm bm ( pat.begin (), pat.end ());
+    BOOST_CHECK ( bm ( corpus.begin (), corpus.end ()) == corpus.end ());
+    BOOST_CHECK_EQUAL ( bm.stats ().comparisons, 3U );
+    BOOST_CHECK_EQUAL ( bm.stats ().total_shift, 9U );
+    BOOST_CHECK_EQUAL ( bm.stats ().max_shift, 3U );
+
+    counting_kmp kmp ( pat.begin (), pat.end ());
+    BOOST_CHECK ( kmp ( corpus.begin (), corpus.end ()) == corpus.end ());
+    BOOST_CHECK_EQUAL ( kmp.stats ().comparisons, 7U );    // alignments 0 .. 6
+    BOOST_CHECK_EQUAL ( kmp.stats ().max_shift, 1U );
+    BOOST_CHECK_EQUAL ( kmp.stats ().average_shift (), 1.0 );
+    }
+
+//  A match compares the whole pattern; the counts add up until they are reset
+    {
+    const std::string corpus ( "xxxxabcxxx" );
+    const std::string pat ( "abc" );
+    counting_bmh bmh ( pat.begin (), pat.end ());
+    BOOST_CHECK ( bmh ( corpus.begin (), corpus.end ()) == corpus.begin () + 4 );
+    BOOST_CHECK_EQUAL ( bmh.stats ().max_verification, 3U );
+    const boost::uintmax_t k_comparisons = bmh.stats ().comparisons;
+    BOOST_CHECK ( bmh ( corpus.begin (), corpus.end ()) == corpus.begin () + 4 );
+    BOOST_CHECK_EQUAL ( bmh.stats ().comparisons, 2 * k_comparisons );
+    bmh.reset_stats ();
+    BOOST_CHECK_EQUAL ( bmh.stats ().comparisons, 0U );
+    BOOST_CHECK_EQUAL ( bmh.stats ().shifts, 0U );
+    BOOST_CHECK_EQUAL ( bmh.stats ().average_shift (), 0.0 );
+    }
+
+//  A degenerate pattern on a degenerate corpus makes K-M-P shift one at a time
+    {
+    const std::string corpus ( 1000, 'a' );
+    const std::string pat = std::string ( 9, 'a' ) + "b";
+    counting_kmp kmp ( pat.begin (), pat.end ());
+    BOOST_CHECK ( kmp ( corpus.begin (), corpus.end ()) == corpus.end ());
+    BOOST_CHECK_EQUAL ( kmp.stats ().max_verification, 10U );
+    BOOST_CHECK ( kmp.stats ().comparisons < 2 * corpus.size ());
+    BOOST_CHECK_EQUAL ( kmp.stats ().max_shift, 1U );
+
+    counting_bmh bmh ( pat.begin (), pat.end ());
+    BOOST_CHECK ( bmh ( corpus.begin (), corpus.end ()) == corpus.end ());
+    BOOST_CHECK_EQUAL ( bmh.stats ().max_shift, 1U );
+    BOOST_CHECK_EQUAL ( bmh.stats ().max_verification, 1U );
+    }
+
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, "ANPANMAN" );
+    check_one ( haystack1, "MAN THE" );
+    check_one ( haystack1, "NOT FOUND" );
+    check_one ( haystack1, "AN" );
+    check_one ( haystack1, "" );
+    check_one ( "", "abc" );
+
+    const std::string dna = make_corpus ( 2000, "AC", 2 );
+    for ( std::size_t len = 1; len <= 20; ++len )
+        for ( std::size_t pos = 0; pos + len <= dna.size (); pos += 197 )
+            check_one ( dna, dna.substr ( pos, len ));
+
+//  The default policy takes no space in the searchers
+    typedef const char *char_ptr;
+    BOOST_CHECK_EQUAL ( sizeof ( ba::knuth_morris_pratt<char_ptr> ),
+                        2 * sizeof ( char_ptr ) + sizeof ( std::ptrdiff_t ) + sizeof ( std::vector<std::ptrdiff_t> ));
+    BOOST_CHECK_EQUAL ( sizeof ( ba::boyer_moore_horspool<char_ptr> ),
+                        2 * sizeof ( char_ptr ) + sizeof ( std::ptrdiff_t ) + sizeof ( ba::detail::BM_traits<char_ptr>::skip_table_t ));
+    return 0;
+}
@@ -10,6 +10,7 @@
 #include <boost/algorithm/searching/boyer_moore.hpp>
 #include <boost/algorithm/searching/boyer_moore_horspool.hpp>
 #include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/shift_or.hpp>
 
 #include <boost/test/included/test_exec_monitor.hpp>
 
@@ -45,6 +46,7 @@ namespace {
         iter_type it1r = ba::boyer_moore_search          (haystack, nBeg, nEnd);
         iter_type it2  = ba::boyer_moore_horspool_search (hBeg, hEnd, nBeg, nEnd);
         iter_type it3  = ba::knuth_morris_pratt_search   (hBeg, hEnd, nBeg, nEnd);
+        iter_type it4  = ba::shift_or_search             (hBeg, hEnd, nBeg, nEnd);
         const int dist = it1 == hEnd ? -1 : std::distance ( hBeg, it1 );
 
         std::cout << "(Iterators) Pattern is " << needle.length () << ", haysstack is " << haystack.length () << " chars long; " << std::endl;
@@ -68,6 +70,10 @@ namespace {
                 throw std::runtime_error ( 
                     std::string ( "results mismatch between boyer-moore and knuth-morris-pratt search" ));
 
+            if ( it1 != it4 )
+                throw std::runtime_error (
+                    std::string ( "results mismatch between boyer-moore and shift-or search" ));
+
             }
 
         catch ( ... ) {
@@ -78,6 +84,7 @@ namespace {
             std::cout << "  bm(r):  " << std::distance ( hBeg, it1r ) << "\n";
             std::cout << "  bmh:    " << std::distance ( hBeg, it2 ) << "\n";
             std::cout << "  kpm:    " << std::distance ( hBeg, it3 )<< "\n";
+            std::cout << "  so:     " << std::distance ( hBeg, it4 )<< "\n";
             std::cout << std::flush;
             throw ;
             }
@@ -99,6 +106,7 @@ namespace {
         ptr_type it1  = ba::boyer_moore_search          (hBeg, hEnd, nBeg, nEnd);
         ptr_type it2  = ba::boyer_moore_horspool_search (hBeg, hEnd, nBeg, nEnd);
         ptr_type it3  = ba::knuth_morris_pratt_search   (hBeg, hEnd, nBeg, nEnd);
+        ptr_type it4  = ba::shift_or_search             (hBeg, hEnd, nBeg, nEnd);
         const int dist = it1 == hEnd ? -1 : std::distance ( hBeg, it1 );
 
         std::cout << "(Pointers) Pattern is " << needle.length () << ", haysstack is " << haystack.length () << " chars long; " << std::endl;
@@ -117,6 +125,10 @@ namespace {
                 throw std::runtime_error ( 
                     std::string ( "results mismatch between boyer-moore and knuth-morris-pratt search" ));
 
+            if ( it1 != it4 )
+                throw std::runtime_error (
+                    std::string ( "results mismatch between boyer-moore and shift-or search" ));
+
             }
 
         catch ( ... ) {
@@ -126,6 +138,7 @@ namespace {
             std::cout << "  bm:     " << std::distance ( hBeg, it1 ) << "\n";
             std::cout << "  bmh:    " << std::distance ( hBeg, it2 ) << "\n";
             std::cout << "  kpm:    " << std::distance ( hBeg, it3 )<< "\n";
+            std::cout << "  so:     " << std::distance ( hBeg, it4 )<< "\n";
             std::cout << std::flush;
             throw ;
             }
@@ -148,6 +161,7 @@ namespace {
         ba::boyer_moore<pattern_type>          bm    ( nBeg, nEnd );
         ba::boyer_moore_horspool<pattern_type> bmh   ( nBeg, nEnd );
         ba::knuth_morris_pratt<pattern_type>   kmp   ( nBeg, nEnd );
+        ba::shift_or<pattern_type>             so    ( nBeg, nEnd );
         
         iter_type it0  = std::search  (hBeg, hEnd, nBeg, nEnd);
         iter_type it1  = bm           (hBeg, hEnd);
@@ -156,6 +170,7 @@ namespace {
         iter_type rt1r = bm_r         (haystack);
         iter_type it2  = bmh          (hBeg, hEnd);
         iter_type it3  = kmp          (hBeg, hEnd);
+        iter_type it4  = so           (hBeg, hEnd);
         const int dist = it1 == hEnd ? -1 : std::distance ( hBeg, it1 );
 
         std::cout << "(Objects) Pattern is " << needle.length () << ", haysstack is " << haystack.length () << " chars long; " << std::endl;
@@ -189,6 +204,10 @@ namespace {
                 throw std::runtime_error ( 
                     std::string ( "results mismatch between boyer-moore and knuth-morris-pratt search" ));
 
+            if ( it1 != it4 )
+                throw std::runtime_error (
+                    std::string ( "results mismatch between boyer-moore and shift-or search" ));
+
             }
 
         catch ( ... ) {
@@ -201,6 +220,7 @@ namespace {
             std::cout << "  bm(r3):  " << std::distance ( hBeg, rt1r ) << "\n";
             std::cout << "  bmh:    " << std::distance ( hBeg, it2 ) << "\n";
             std::cout << "  kpm:    " << std::distance ( hBeg, it3 )<< "\n";
+            std::cout << "  so:     " << std::distance ( hBeg, it4 )<< "\n";
             std::cout << std::flush;
             throw ;
             }
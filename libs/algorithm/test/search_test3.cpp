@@ -10,6 +10,7 @@
 #include <boost/algorithm/searching/boyer_moore.hpp>
 #include <boost/algorithm/searching/boyer_moore_horspool.hpp>
 #include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/shift_or.hpp>
 
 #include <boost/test/included/test_exec_monitor.hpp>
 
@@ -119,6 +120,8 @@ namespace {
         runObject ( boyer_moore_horspool,        stdDiff );
         runOne    ( knuth_morris_pratt_search,   stdDiff );
         runObject ( knuth_morris_pratt,          stdDiff );
+        runOne    ( shift_or_search,             stdDiff );
+        runObject ( shift_or,                    stdDiff );
         }
     }
 
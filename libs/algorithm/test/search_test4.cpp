@@ -0,0 +1,146 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/shift_or.hpp>
+
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+    typedef std::vector<str_iter> match_vec;
+
+//  The reference implementation: restart std::search after every match
+    match_vec naive_find_all ( const std::string &haystack, const std::string &needle, bool overlapping ) {
+        match_vec retVal;
+        str_iter it = haystack.begin ();
+        while (( it = std::search ( it, haystack.end (), needle.begin (), needle.end ())) != haystack.end ()) {
+            retVal.push_back ( it );
+            if ( needle.empty ()) break;
+            it += overlapping ? 1 : needle.size ();
+            }
+        return retVal;
+        }
+
+    void check_mode ( const std::string &haystack, const std::string &needle, bool overlapping, std::size_t expected ) {
+        str_iter hBeg = haystack.begin ();
+        str_iter hEnd = haystack.end ();
+        str_iter nBeg = needle.begin ();
+        str_iter nEnd = needle.end ();
+
+        const match_vec exp = naive_find_all ( haystack, needle, overlapping );
+        match_vec r1, r2, r3, r4, o1, o2, o3, o4;
+
+        ba::boyer_moore_find_all          ( hBeg, hEnd, nBeg, nEnd, std::back_inserter ( r1 ), overlapping );
+        ba::boyer_moore_horspool_find_all ( hBeg, hEnd, nBeg, nEnd, std::back_inserter ( r2 ), overlapping );
+        ba::knuth_morris_pratt_find_all   ( hBeg, hEnd, nBeg, nEnd, std::back_inserter ( r3 ), overlapping );
+        ba::shift_or_find_all             ( hBeg, hEnd, nBeg, nEnd, std::back_inserter ( r4 ), overlapping );
+
+        ba::boyer_moore<str_iter>          bm  ( nBeg, nEnd );
+        ba::boyer_moore_horspool<str_iter> bmh ( nBeg, nEnd );
+        ba::knuth_morris_pratt<str_iter>   kmp ( nBeg, nEnd );
+        ba::shift_or<str_iter>             so  ( nBeg, nEnd );
+        bm.find_all  ( hBeg, hEnd, std::back_inserter ( o1 ), overlapping );
+        bmh.find_all ( hBeg, hEnd, std::back_inserter ( o2 ), overlapping );
+        kmp.find_all ( hBeg, hEnd, std::back_inserter ( o3 ), overlapping );
+        so.find_all  ( hBeg, hEnd, std::back_inserter ( o4 ), overlapping );
+
+        std::cout << "(find_all) Pattern is " << needle.length () << ", haystack is " << haystack.length ()
+                  << " chars long; " << ( overlapping ? "overlapping" : "non-overlapping" ) << std::endl;
+        BOOST_CHECK_EQUAL ( exp.size (), expected );
+        BOOST_CHECK ( r1 == exp );
+        BOOST_CHECK ( r2 == exp );
+        BOOST_CHECK ( r3 == exp );
+        BOOST_CHECK ( r4 == exp );
+        BOOST_CHECK ( o1 == exp );
+        BOOST_CHECK ( o2 == exp );
+        BOOST_CHECK ( o3 == exp );
+        BOOST_CHECK ( o4 == exp );
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle,
+                            std::size_t overlapping, std::size_t non_overlapping ) {
+        check_mode ( haystack, needle, true,  overlapping );
+        check_mode ( haystack, needle, false, non_overlapping );
+        }
+
+//  Count the number of times that the corpus is read
+    std::size_t reads = 0;
+    struct count_reads {
+        typedef char result_type;
+        char operator () ( char c ) const { ++reads; return c; }
+        };
+    typedef boost::transform_iterator<count_reads, str_iter> counting_iter;
+
+//  With Galil's rule, finding all the matches of a periodic pattern in a periodic
+//  corpus reads each element of the corpus a bounded number of times.
+    void check_linear ( const std::string &haystack, const std::string &needle ) {
+        std::vector<counting_iter> res;
+        ba::boyer_moore<str_iter> bm ( needle.begin (), needle.end ());
+        reads = 0;
+        bm.find_all ( counting_iter ( haystack.begin ()), counting_iter ( haystack.end ()), std::back_inserter ( res ));
+        BOOST_CHECK_EQUAL ( res.size (), naive_find_all ( haystack, needle, true ).size ());
+        BOOST_CHECK_LE ( reads, 3 * haystack.size ());
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    const std::string haystack2 ( "ABC ABCDAB ABCDABCDABDE" );
+    const std::string haystack3 ( "abra abracad abracadabra" );
+    const std::string haystack4 ( 40, 'a' );
+    const std::string haystack5 ( "abababababab" );
+    const std::string empty;
+
+    check_one ( haystack1, "AN",        6, 6 );
+    check_one ( haystack1, "ANPANMAN",  1, 1 );
+    check_one ( haystack1, "NOT FOUND", 0, 0 );
+    check_one ( haystack1, haystack1,   1, 1 );
+    check_one ( haystack2, "ABCDAB",    3, 2 );
+    check_one ( haystack3, "abra",      4, 4 );
+    check_one ( haystack3, "abracadabra", 1, 1 );
+    check_one ( haystack4, "a",        40, 40 );
+    check_one ( haystack4, "aaa",      38, 13 );
+    check_one ( haystack4, "aaab",      0, 0 );
+    check_one ( haystack5, "abab",      5, 3 );
+    check_one ( haystack5, "bab",       5, 3 );
+
+    check_one ( haystack1, empty,       1, 1 );   // the empty pattern is found once, at the start
+    check_one ( empty,     "abc",       0, 0 );   // nothing in an empty haystack
+    check_one ( "abc",     haystack1,   0, 0 );   // can't find long pattern in short corpus
+
+//  Patterns longer than a machine word (shift_or checks the tail separately)
+    const std::string haystack6 ( 200, 'a' );
+    check_one ( haystack6, std::string ( 64, 'a' ),  137, 3 );
+    check_one ( haystack6, std::string ( 65, 'a' ),  136, 3 );
+    check_one ( haystack6, std::string ( 100, 'a' ), 101, 2 );
+    check_one ( haystack6, std::string ( 99, 'a' ) + 'b', 0, 0 );
+
+    check_linear ( std::string ( 100000, 'a' ), std::string ( 100, 'a' ));
+    std::string abs;
+    while ( abs.size () < 100000 )
+        abs += "ab";
+    check_linear ( abs, abs.substr ( 0, 200 ));
+    check_linear ( abs, abs.substr ( 1, 199 ));
+    return 0;
+    }
@@ -0,0 +1,128 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/shift_or.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+//  Searching sequences of 16, 32 and 64 bit values, which use the
+//  flat array and the open-addressed skip tables.
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    template <typename T>
+    void check_one ( const std::vector<T> &haystack, const std::vector<T> &needle ) {
+        typedef typename std::vector<T>::const_iterator iter;
+        const iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+
+        BOOST_CHECK ( ba::boyer_moore_search          ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == exp );
+        BOOST_CHECK ( ba::boyer_moore_horspool_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == exp );
+        BOOST_CHECK ( ba::knuth_morris_pratt_search   ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == exp );
+        BOOST_CHECK ( ba::shift_or_search             ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == exp );
+        }
+
+    template <typename T>
+    void check_type ( T base ) {
+        for ( unsigned alpha = 2; alpha <= 1000; alpha *= 7 ) {
+            const std::vector<T> haystack = make_corpus<T> ( 5000, base, alpha );
+            for ( std::size_t len = 1; len < 300; len = len * 3 + 1 ) {
+            //  Patterns taken from the corpus, and random ones (which probably don't occur)
+                check_one ( haystack, std::vector<T> ( haystack.begin () + 4000, haystack.begin () + 4000 + len ));
+                check_one ( haystack, std::vector<T> ( haystack.end () - len, haystack.end ()));
+                check_one ( haystack, make_corpus<T> ( len, base, alpha ));
+                }
+            check_one ( haystack, std::vector<T> ());
+            check_one ( std::vector<T> (), haystack );
+            }
+        }
+
+//  The compact table marks its empty slots with a key value that isn't in the table;
+//  make sure that patterns containing the initial marker (the largest value) work.
+    template <typename T>
+    void check_extremes () {
+        const T hi = (std::numeric_limits<T>::max) ();
+        const T lo = (std::numeric_limits<T>::min) ();
+        std::vector<T> haystack;
+        for ( int i = 0; i < 100; ++i ) {
+            haystack.push_back ( static_cast<T> ( i ));
+            haystack.push_back ( i % 3 ? hi : lo );
+            haystack.push_back ( static_cast<T> ( hi - 1 ));
+            }
+        for ( std::size_t len = 1; len < 10; ++len ) {
+            check_one ( haystack, std::vector<T> ( haystack.begin () + 150, haystack.begin () + 150 + len ));
+            check_one ( haystack, std::vector<T> ( len, hi ));
+            std::vector<T> needle ( len, hi );
+            needle [ 0 ] = static_cast<T> ( hi - 1 );
+            check_one ( haystack, needle );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+//  Make sure the expected tables are chosen
+    typedef ba::detail::BM_traits<std::vector<boost::uint16_t>::const_iterator>::skip_table_t t16;
+    typedef ba::detail::BM_traits<std::vector<boost::int32_t>::const_iterator>::skip_table_t t32;
+    typedef ba::detail::BM_traits<std::vector<std::string>::const_iterator>::skip_table_t tstr;
+    BOOST_CHECK (( boost::is_same<t16, ba::detail::skip_table<boost::uint16_t, std::ptrdiff_t, true> >::value ));
+    BOOST_CHECK (( boost::is_same<t32, ba::detail::compact_skip_table<boost::int32_t, std::ptrdiff_t> >::value ));
+    BOOST_CHECK (( boost::is_same<tstr, ba::detail::skip_table<std::string, std::ptrdiff_t, false> >::value ));
+
+//  The 64K entry table for 16-bit keys is not inside the searcher
+    BOOST_CHECK ( sizeof ( ba::boyer_moore_horspool<const boost::uint16_t *> ) < 1024 );
+    BOOST_CHECK ( sizeof ( ba::boyer_moore<const boost::uint16_t *> ) < 1024 );
+
+    check_type<boost::uint16_t> ( 0 );
+    check_type<boost::int16_t>  ( -500 );
+    check_type<wchar_t>         ( L'a' );
+    check_type<int>             ( -100 );
+    check_type<boost::uint32_t> ( 0xFFFFFF00U );
+    check_type<boost::int64_t>  ( 1000000000000LL );
+
+    check_extremes<boost::uint16_t> ();
+    check_extremes<int> ();
+    check_extremes<boost::uint32_t> ();
+    check_extremes<boost::int64_t> ();
+    check_extremes<boost::uint64_t> ();
+
+//  Exercise the skip table directly, including reassigning the empty marker
+    ba::detail::compact_skip_table<int, int> tbl ( 4, -1 );
+    const int big = (std::numeric_limits<int>::max) ();
+    tbl.insert ( big, 1 );
+    tbl.insert ( big - 1, 2 );
+    tbl.insert ( 17, 3 );
+    tbl.insert ( big, 4 );
+    BOOST_CHECK_EQUAL ( tbl [ big ], 4 );
+    BOOST_CHECK_EQUAL ( tbl [ big - 1 ], 2 );
+    BOOST_CHECK_EQUAL ( tbl [ 17 ], 3 );
+    BOOST_CHECK_EQUAL ( tbl [ 18 ], -1 );
+    BOOST_CHECK_EQUAL ( tbl [ (std::numeric_limits<int>::min) () ], -1 );
+    tbl.insert ( (std::numeric_limits<int>::min) (), 5 );
+    BOOST_CHECK_EQUAL ( tbl [ (std::numeric_limits<int>::min) () ], 5 );
+    BOOST_CHECK_EQUAL ( tbl [ big ], 4 );
+    BOOST_CHECK_EQUAL ( tbl [ 18 ], -1 );
+
+    return 0;
+    }
@@ -0,0 +1,213 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool_simd.hpp>
+#include <boost/algorithm/searching/stream_search.hpp>
+#include <boost/algorithm/searching/reverse_search.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+//  Searching with folded traits; case-insensitive searching, and a user-defined fold.
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+    typedef ba::case_insensitive_traits<str_iter> icase_traits;
+    typedef ba::case_insensitive_traits<std::reverse_iterator<str_iter> > icase_rev_traits;
+
+    template <typename Fold>
+    struct folded_equal {
+        template <typename T>
+        bool operator () ( T a, T b ) const { return Fold::apply ( a ) == Fold::apply ( b ); }
+        };
+
+    std::vector<str_iter> std_find_all ( const std::string &haystack, const std::string &needle ) {
+        std::vector<str_iter> retVal;
+        if ( needle.empty () || haystack.size () < needle.size ())
+            return retVal;
+        for ( str_iter it = haystack.begin (); it + needle.size () <= haystack.end (); ++it )
+            if ( std::equal ( needle.begin (), needle.end (), it, folded_equal<ba::ascii_case_fold> ()))
+                retVal.push_back ( it );
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        const str_iter exp = std::search ( haystack.begin (), haystack.end (),
+                    needle.begin (), needle.end (), folded_equal<ba::ascii_case_fold> ());
+
+        ba::boyer_moore<str_iter, icase_traits> bm ( needle.begin (), needle.end ());
+        ba::boyer_moore_horspool<str_iter, icase_traits> bmh ( needle.begin (), needle.end ());
+        BOOST_CHECK ( bm  ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( bmh ( haystack.begin (), haystack.end ()) == exp );
+
+    //  The vectorized searcher hands folded searches to B-M-H
+        ba::boyer_moore_horspool_simd<const char *, ba::case_insensitive_traits<const char *> >
+            simd ( needle.data (), needle.data () + needle.size ());
+        const char *res = simd ( haystack.data (), haystack.data () + haystack.size ());
+        BOOST_CHECK ( res - haystack.data () == std::distance ( haystack.begin (), exp ));
+
+        if ( needle.empty ())
+            return;
+
+    //  All the matches
+        const std::vector<str_iter> all = std_find_all ( haystack, needle );
+        std::vector<str_iter> found;
+        bm.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( found ));
+        BOOST_CHECK ( found == all );
+        found.clear ();
+        bmh.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( found ));
+        BOOST_CHECK ( found == all );
+
+    //  The last match
+        ba::reverse_boyer_moore<str_iter, icase_rev_traits> rbm ( needle.begin (), needle.end ());
+        BOOST_CHECK ( rbm ( haystack.begin (), haystack.end ()) == ( all.empty () ? haystack.end () : all.back ()));
+
+    //  The same matches, a few elements at a time
+        ba::boyer_moore_horspool_stream<str_iter, icase_traits> stream ( needle.begin (), needle.end ());
+        std::vector<boost::uintmax_t> offsets;
+        for ( std::size_t i = 0; i < haystack.size (); i += 7 )
+            stream.feed ( haystack.begin () + i, haystack.begin () + (std::min) ( i + 7, haystack.size ()),
+                        std::back_inserter ( offsets ));
+        BOOST_REQUIRE ( offsets.size () == all.size ());
+        for ( std::size_t i = 0; i < all.size (); ++i )
+            BOOST_CHECK ( offsets [ i ] == boost::uintmax_t ( all [ i ] - haystack.begin ()));
+        }
+
+//  Random letters of both cases, from a small alphabet, and some punctuation
+    std::string make_corpus ( std::size_t len, unsigned alpha_size ) {
+        std::string retVal ( len, ' ' );
+        for ( std::size_t i = 0; i < len; ++i ) {
+            const int r = std::rand () % ( 2 * alpha_size + 2 );
+            if      ( r < (int) alpha_size )     retVal [ i ] = static_cast<char> ( 'a' + r );
+            else if ( r < 2 * (int) alpha_size ) retVal [ i ] = static_cast<char> ( 'A' + r - alpha_size );
+            else                                 retVal [ i ] = r & 1 ? '@' : '[';    // just outside 'A'..'Z'
+            }
+        return retVal;
+        }
+
+//  A user-defined fold: match integers by their value mod 10
+    struct mod10_fold {
+        static int apply ( int t ) { return t % 10; }
+        };
+
+//  Traits which don't mention a fold at all
+    struct plain_traits {
+        typedef std::ptrdiff_t value_type;
+        typedef int key_type;
+        typedef ba::detail::compact_skip_table<int, std::ptrdiff_t> skip_table_t;
+        };
+
+//  An element that counts how many times it is copied
+    std::size_t copies = 0;
+
+    struct counted {
+        explicit counted ( int v ) : value ( v ) {}
+        counted ( const counted &other ) : value ( other.value ) { ++copies; }
+        counted &operator = ( const counted &other ) { value = other.value; ++copies; return *this; }
+        bool operator == ( const counted &other ) const { return value == other.value; }
+        int value;
+        };
+
+//  A skip table for 'counted', which takes its keys by reference
+    class counted_skip_table {
+    public:
+        counted_skip_table ( std::size_t, std::ptrdiff_t default_value ) : skip_ ( 16, default_value ) {}
+        void insert ( const counted &key, std::ptrdiff_t val ) { skip_ [ key.value ] = val; }
+        std::ptrdiff_t operator [] ( const counted &key ) const { return skip_ [ key.value ]; }
+    private:
+        std::vector<std::ptrdiff_t> skip_;
+        };
+
+    struct counted_traits {
+        typedef std::ptrdiff_t value_type;
+        typedef counted key_type;
+        typedef counted_skip_table skip_table_t;
+        };
+
+//  Without a fold, the searches don't copy the elements
+    void check_no_copies () {
+        std::vector<counted> haystack;
+        for ( std::size_t i = 0; i < 10000; ++i )
+            haystack.push_back ( counted ( std::rand () % 16 ));
+        const std::vector<counted> needle ( haystack.begin () + 9000, haystack.begin () + 9010 );
+        typedef std::vector<counted>::const_iterator counted_iter;
+
+        ba::boyer_moore<counted_iter, counted_traits> bm ( needle.begin (), needle.end ());
+        ba::boyer_moore_horspool<counted_iter, counted_traits> bmh ( needle.begin (), needle.end ());
+        copies = 0;
+        const counted_iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( bm  ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( bmh ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK_EQUAL ( copies, 0U );
+        }
+
+    void check_ints () {
+        std::vector<int> haystack ( 3000 );
+        for ( std::size_t i = 0; i < haystack.size (); ++i )
+            haystack [ i ] = std::rand () % 40;
+        typedef std::vector<int>::const_iterator int_iter;
+        typedef ba::folding_traits<int_iter, mod10_fold> mod10_traits;
+
+        for ( std::size_t len = 1; len < 20; len += 3 ) {
+            std::vector<int> needle ( haystack.begin () + 2000, haystack.begin () + 2000 + len );
+            for ( std::size_t i = 0; i < needle.size (); ++i )
+                needle [ i ] = ( needle [ i ] + 10 * ( i % 3 )) % 40;   // same value mod 10
+
+            const int_iter exp = std::search ( haystack.begin (), haystack.end (),
+                        needle.begin (), needle.end (), folded_equal<mod10_fold> ());
+            BOOST_CHECK ( exp <= haystack.begin () + 2000 );
+            ba::boyer_moore<int_iter, mod10_traits> bm ( needle.begin (), needle.end ());
+            ba::boyer_moore_horspool<int_iter, mod10_traits> bmh ( needle.begin (), needle.end ());
+            BOOST_CHECK ( bm  ( haystack.begin (), haystack.end ()) == exp );
+            BOOST_CHECK ( bmh ( haystack.begin (), haystack.end ()) == exp );
+
+        //  No fold; an exact search
+            const int_iter exact = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+            ba::boyer_moore<int_iter, plain_traits> bm2 ( needle.begin (), needle.end ());
+            BOOST_CHECK ( bm2 ( haystack.begin (), haystack.end ()) == exact );
+            }
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    check_one ( "Hello, World", "WORLD" );
+    check_one ( "Hello, World", "hello" );
+    check_one ( "Hello, World", "o, w" );
+    check_one ( "Hello, World", "World!" );
+    check_one ( "Hello, World", "" );
+    check_one ( "", "abc" );
+    check_one ( "@[@[ABAB", "`{" );             // the neighbours of 'A' and 'Z' don't fold
+    check_one ( "AbAbAbAbaBAB", "abab" );
+
+    for ( unsigned alpha = 1; alpha <= 26; alpha *= 3 ) {
+        const std::string haystack = make_corpus ( 3000, alpha );
+        for ( std::size_t len = 1; len < 200; len = len * 2 + 1 ) {
+            std::string needle = haystack.substr ( 2500, len );
+            check_one ( haystack, needle );
+            std::transform ( needle.begin (), needle.end (), needle.begin (), ba::ascii_case_fold::apply<char> );
+            check_one ( haystack, needle );
+            check_one ( haystack, make_corpus ( len, alpha ));
+            }
+        }
+
+    check_ints ();
+    check_no_copies ();
+    return 0;
+}
@@ -0,0 +1,42 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+//  Helpers shared by the searching tests
+
+#ifndef BOOST_ALGORITHM_TEST_SEARCH_TEST_UTIL_HPP
+#define BOOST_ALGORITHM_TEST_SEARCH_TEST_UTIL_HPP
+
+#include <cstdlib>      // for std::rand
+#include <string>
+#include <vector>
+
+//  A random corpus drawn from the first 'alpha_size' characters of 'alphabet'.
+//  A small alphabet gives lots of matches and near misses.
+inline std::string make_corpus ( std::size_t len, const char *alphabet, std::size_t alpha_size ) {
+    std::string retVal ( len, ' ' );
+    for ( std::size_t i = 0; i < len; ++i )
+        retVal [ i ] = alphabet [ std::rand () % alpha_size ];
+    return retVal;
+    }
+
+//  A random piece of 'corpus', 'len' long; a pattern that is sure to be found
+inline std::string random_substr ( const std::string &corpus, std::size_t len ) {
+    return corpus.substr ( std::rand () % ( corpus.size () - len ), len );
+    }
+
+//  Random values from a small alphabet 'base, base + 1, ..., base + alpha_size - 1'
+template <typename T>
+std::vector<T> make_corpus ( std::size_t len, T base, unsigned alpha_size ) {
+    std::vector<T> retVal ( len );
+    for ( std::size_t i = 0; i < len; ++i )
+        retVal [ i ] = static_cast<T> ( base + static_cast<T> ( std::rand () % alpha_size ));
+    return retVal;
+    }
+
+#endif  //  BOOST_ALGORITHM_TEST_SEARCH_TEST_UTIL_HPP
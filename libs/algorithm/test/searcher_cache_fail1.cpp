@@ -0,0 +1,23 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <vector>
+#include <boost/algorithm/searching/searcher_cache.hpp>
+
+int main( int argc, char *argv [] )
+{
+    std::vector<unsigned char> pat;
+    boost::algorithm::searcher_cache<char> cache;
+
+//  Should fail to compile because the pattern is not made of 'char'
+    (void) cache.get ( pat.begin (), pat.end ());
+
+    (void) argv; (void) argc;
+    return 0;
+}
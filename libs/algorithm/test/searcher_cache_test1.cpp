@@ -0,0 +1,142 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/searcher_cache.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  An allocator that counts the number of allocations made through it
+    std::size_t allocations = 0;
+
+    template <typename T>
+    struct counting_allocator : public std::allocator<T> {
+        typedef T value_type;
+        template <typename U> struct rebind { typedef counting_allocator<U> other; };
+
+        counting_allocator () {}
+        template <typename U> counting_allocator ( const counting_allocator<U> & ) {}
+
+        T *allocate ( std::size_t n, const void * = 0 ) {
+            ++allocations;
+            return std::allocator<T>().allocate ( n );
+            }
+        void deallocate ( T *p, std::size_t n ) { std::allocator<T>().deallocate ( p, n ); }
+        };
+
+    template <typename T, typename U>
+    bool operator == ( const counting_allocator<T> &, const counting_allocator<U> & ) { return true; }
+    template <typename T, typename U>
+    bool operator != ( const counting_allocator<T> &, const counting_allocator<U> & ) { return false; }
+
+    typedef std::string::const_iterator str_iter;
+    typedef counting_allocator<std::ptrdiff_t> alloc_type;
+
+    void check_allocators ( const std::string &haystack, const std::string &needle ) {
+        const str_iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+
+        allocations = 0;
+        ba::boyer_moore<str_iter, ba::folding_traits<str_iter>, ba::no_search_stats, alloc_type> bm ( needle.begin (), needle.end ());
+        BOOST_CHECK ( allocations > 0 );
+        BOOST_CHECK ( bm ( haystack.begin (), haystack.end ()) == exp );
+
+        allocations = 0;
+        ba::knuth_morris_pratt<str_iter, ba::no_search_stats, alloc_type> kmp ( needle.begin (), needle.end (), alloc_type ());
+        BOOST_CHECK_EQUAL ( allocations, 1U );
+        BOOST_CHECK ( kmp ( haystack.begin (), haystack.end ()) == exp );
+        }
+
+    template <typename Cache>
+    void check_cache ( Cache &cache, const std::string &haystack, const std::string &needle ) {
+        const str_iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( cache.search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == exp );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    const char *needles [] = { "ANPANMAN", "MAN THE", "NOW ", "NEND", "NOT FOUND", "AN", "", "ANN" };
+    const std::size_t num_needles = sizeof ( needles ) / sizeof ( needles [ 0 ] );
+
+    for ( std::size_t i = 0; i < num_needles; ++i )
+        check_allocators ( haystack1, needles [ i ] );
+
+//  The same searcher comes back for the same pattern, even from a different buffer
+    ba::searcher_cache<char> cache ( 4 );
+    std::string p1 ( "ANPANMAN" );
+    const std::vector<char> p2 ( p1.begin (), p1.end ());
+    ba::searcher_cache<char>::searcher_ptr s1 = cache.get ( p1.begin (), p1.end ());
+    ba::searcher_cache<char>::searcher_ptr s2 = cache.get ( p2.begin (), p2.end ());
+    BOOST_CHECK ( s1 == s2 );
+    BOOST_CHECK_EQUAL ( cache.size (), 1U );
+
+//  The cache has its own copy of the pattern
+    p1 = "XXXXXXXX";
+    BOOST_CHECK ( (*s1) ( haystack1.begin (), haystack1.end ()) == haystack1.begin () + 26 );
+
+//  Check the results, with more patterns than will fit in the cache
+    for ( int rep = 0; rep < 3; ++rep )
+        for ( std::size_t i = 0; i < num_needles; ++i )
+            check_cache ( cache, haystack1, needles [ i ] );
+    BOOST_CHECK_EQUAL ( cache.size (), 4U );
+
+//  Evicted searchers stay alive while they are being used
+    BOOST_CHECK ( s1 != cache.get ( p2.begin (), p2.end ()));
+    BOOST_CHECK ( (*s1) ( haystack1.begin (), haystack1.end ()) == haystack1.begin () + 26 );
+
+//  The least recently used pattern goes first
+    cache.clear ();
+    const std::string a ( "A" ), b ( "B" ), c ( "C" ), d ( "D" ), e ( "E" );
+    ba::searcher_cache<char>::searcher_ptr sa = cache.get ( a.begin (), a.end ());
+    cache.get ( b.begin (), b.end ());
+    cache.get ( c.begin (), c.end ());
+    cache.get ( d.begin (), d.end ());
+    BOOST_CHECK ( sa == cache.get ( a.begin (), a.end ()));    // a is now the most recent
+    cache.get ( e.begin (), e.end ());                          // b goes away
+    BOOST_CHECK ( sa == cache.get ( a.begin (), a.end ()));
+    BOOST_CHECK_EQUAL ( cache.size (), 4U );
+
+//  Patterns with bytes above 0x7F are evicted cleanly, even when they are the only entry
+    {
+    ba::searcher_cache<char> one ( 1 );
+    const char hi [] = { char ( 200 ), char ( 201 ) };
+    const char lo [] = { 1, 2 };
+    const std::string corpus = std::string ( "xx" ) + std::string ( hi, hi + 2 ) + "x";
+    ba::searcher_cache<char>::searcher_ptr s_hi = one.get ( hi, hi + 2 );
+    one.get ( lo, lo + 2 );
+    BOOST_CHECK ( s_hi != one.get ( hi, hi + 2 ));
+    one.get ( lo, lo + 2 );
+    BOOST_CHECK_EQUAL ( one.size (), 1U );
+    BOOST_CHECK ( one.search ( corpus.begin (), corpus.end (), hi, hi + 2 ) == corpus.begin () + 2 );
+    }
+
+//  Other searchers work too
+    ba::searcher_cache<char, ba::knuth_morris_pratt<const char *> > kmp_cache;
+    ba::searcher_cache<char, ba::boyer_moore_horspool<const char *> > bmh_cache;
+    for ( std::size_t i = 0; i < num_needles; ++i ) {
+        check_cache ( kmp_cache, haystack1, needles [ i ] );
+        check_cache ( bmh_cache, haystack1, needles [ i ] );
+        }
+    return 0;
+    }
@@ -0,0 +1,217 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/searcher_tables.hpp>
+#include <boost/algorithm/searching/mapped_corpus.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::vector<char> vec;
+    typedef vec::const_iterator vec_iter;
+
+    vec ReadFromFile ( const char *name ) {
+        std::ifstream in ( name, std::ios_base::binary | std::ios_base::in );
+        return vec ( std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char> ());
+        }
+
+//  A blob, in storage that is aligned for the tables
+    class blob {
+    public:
+        explicit blob ( const vec &pattern ) {
+            std::ostringstream out ( std::ios_base::binary | std::ios_base::out );
+            ba::write_searcher_tables ( pattern, out );
+            const std::string s = out.str ();
+            size_ = s.size ();
+            storage_.resize ( size_ / sizeof ( boost::uint64_t ) + 1 );
+            std::memcpy ( &storage_ [ 0 ], s.data (), size_ );
+            }
+        const void *data () const { return &storage_ [ 0 ]; }
+        std::size_t size () const { return size_; }
+        void *data () { return &storage_ [ 0 ]; }
+    private:
+        std::vector<boost::uint64_t> storage_;
+        std::size_t size_;
+        };
+
+    template <typename Searcher, typename Iter>
+    std::vector<std::ptrdiff_t> all_matches ( const Searcher &s, Iter first, Iter last, bool overlapping ) {
+        std::vector<Iter> res;
+        s.find_all ( first, last, std::back_inserter ( res ), overlapping );
+        std::vector<std::ptrdiff_t> retVal;
+        for ( std::size_t i = 0; i < res.size (); ++i )
+            retVal.push_back ( res [ i ] - first );
+        return retVal;
+        }
+
+//  The mapped searchers should find what the ordinary ones do
+    void check_one ( const vec &haystack, const vec &needle ) {
+        const blob b ( needle );
+        const ba::searcher_tables tables ( b.data (), b.size ());
+        BOOST_REQUIRE_EQUAL ( tables.pattern_length (), needle.size ());
+        BOOST_CHECK ( std::equal ( tables.pattern_begin (), tables.pattern_end (),
+                                    reinterpret_cast<const unsigned char *> ( needle.empty () ? NULL : &needle [ 0 ] )));
+
+        ba::boyer_moore<vec_iter>          bm  ( needle.begin (), needle.end ());
+        ba::boyer_moore_horspool<vec_iter> bmh ( needle.begin (), needle.end ());
+        ba::knuth_morris_pratt<vec_iter>   kmp ( needle.begin (), needle.end ());
+        const ba::mapped_boyer_moore          mbm  ( tables );
+        const ba::mapped_boyer_moore_horspool mbmh ( tables );
+        const ba::mapped_knuth_morris_pratt   mkmp ( tables );
+
+        const vec_iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( mbm  ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( mbmh ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( mkmp ( haystack.begin (), haystack.end ()) == exp );
+
+        for ( int overlapping = 0; overlapping < 2; ++overlapping ) {
+            const std::vector<std::ptrdiff_t> expAll = all_matches ( kmp, haystack.begin (), haystack.end (), overlapping != 0 );
+            BOOST_CHECK ( all_matches ( mbm,  haystack.begin (), haystack.end (), overlapping != 0 ) == expAll );
+            BOOST_CHECK ( all_matches ( mbmh, haystack.begin (), haystack.end (), overlapping != 0 ) == expAll );
+            BOOST_CHECK ( all_matches ( mkmp, haystack.begin (), haystack.end (), overlapping != 0 ) == expAll );
+            BOOST_CHECK ( all_matches ( bm,   haystack.begin (), haystack.end (), overlapping != 0 ) == expAll );
+            BOOST_CHECK ( all_matches ( bmh,  haystack.begin (), haystack.end (), overlapping != 0 ) == expAll );
+            }
+        }
+
+    bool rejected ( const void *data, std::size_t size ) {
+        try { ba::searcher_tables t ( data, size ); }
+        catch ( const ba::searcher_tables_error & ) { return true; }
+        return false;
+        }
+
+//  Is the blob rejected when the table entry at 'offset' is 'val'?
+    bool rejected_entry ( blob &b, std::size_t offset, boost::int32_t val ) {
+        unsigned char *bytes = static_cast<unsigned char *> ( b.data ()) + offset;
+        boost::int32_t saved;
+        std::memcpy ( &saved, bytes, sizeof ( saved ));
+        std::memcpy ( bytes, &val, sizeof ( val ));
+        const bool retVal = rejected ( b.data (), b.size ());
+        std::memcpy ( bytes, &saved, sizeof ( saved ));
+        return retVal;
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string h1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    const vec haystack1 ( h1.begin (), h1.end ());
+    const char *needles [] = { "ANPANMAN", "MAN THE", "WE\220ER", "NOW ", "NEND", "NOT FOUND", "\220", "AN", "" };
+    for ( std::size_t i = 0; i < sizeof ( needles ) / sizeof ( needles [ 0 ] ); ++i )
+        check_one ( haystack1, vec ( needles [ i ], needles [ i ] + std::strlen ( needles [ i ] )));
+    check_one ( vec (), vec ( 3, 'a' ));
+    check_one ( vec ( 2, 'a' ), vec ( 3, 'a' ));
+
+//  Lots of overlapping matches
+    const std::string dna_string = make_corpus ( 2000, "AC", 2 );
+    const vec dna ( dna_string.begin (), dna_string.end ());
+    for ( std::size_t len = 1; len <= 20; ++len )
+        for ( std::size_t pos = 0; pos + len <= dna.size (); pos += 97 )
+            check_one ( dna, vec ( dna.begin () + pos, dna.begin () + pos + len ));
+
+//  The long patterns from the data files, written to a file and mapped back in
+    const vec corpus = ReadFromFile ( "data-files/0001.corpus" );
+    const char *pats [] = { "data-files/0002b.pat", "data-files/0002e.pat", "data-files/0002n.pat" };
+    for ( std::size_t i = 0; i < sizeof ( pats ) / sizeof ( pats [ 0 ] ); ++i ) {
+        const vec needle = ReadFromFile ( pats [ i ] );
+        check_one ( corpus, needle );
+
+        const char *k_file = "searcher_tables_test1.tables";
+        {
+        std::ofstream out ( k_file, std::ios_base::binary | std::ios_base::out );
+        ba::write_searcher_tables ( needle.begin (), needle.end (), out );
+        }
+        {
+        const ba::mapped_corpus mc ( k_file, ba::mapped_corpus::random_access );
+        const ba::searcher_tables tables ( mc.begin (), mc.size ());
+        const ba::mapped_boyer_moore mbm ( tables );
+        BOOST_CHECK ( mbm ( corpus ) == std::search ( corpus.begin (), corpus.end (), needle.begin (), needle.end ()));
+        }
+        std::remove ( k_file );
+        }
+
+//  Damaged blobs
+    {
+    const char pat [] = "ANPANMAN";
+    blob b ( vec ( pat, pat + 8 ));
+    unsigned char *bytes = static_cast<unsigned char *> ( b.data ());
+    BOOST_CHECK ( !rejected ( bytes, b.size ()));
+    BOOST_CHECK ( rejected ( bytes, b.size () - 1 ));       // truncated
+    BOOST_CHECK ( rejected ( bytes, 20 ));
+    BOOST_CHECK ( rejected ( bytes + 4, b.size () - 4 ));   // not at the start
+
+    bytes [ 0 ] ^= 1;                                       // magic
+    BOOST_CHECK ( rejected ( bytes, b.size ()));
+    bytes [ 0 ] ^= 1;
+    bytes [ 8 ] += 1;                                       // version
+    BOOST_CHECK ( rejected ( bytes, b.size ()));
+    bytes [ 8 ] -= 1;
+    std::reverse ( bytes + 12, bytes + 16 );                // byte order
+    BOOST_CHECK ( rejected ( bytes, b.size ()));
+    std::reverse ( bytes + 12, bytes + 16 );
+    bytes [ 16 ] += 1;                                      // pattern length
+    BOOST_CHECK ( rejected ( bytes, b.size ()));
+    bytes [ 16 ] -= 1;
+    bytes [ 40 ] += 4;                                      // an offset
+    BOOST_CHECK ( rejected ( bytes, b.size ()));
+    bytes [ 40 ] -= 4;
+    BOOST_CHECK ( !rejected ( bytes, b.size ()));
+
+//  Table entries that would make the searchers read outside the corpus, or stop moving
+    const std::size_t bm_skip = 72, bmh_skip = bm_skip + 1024, bm_suffix = bmh_skip + 1024, kmp = bm_suffix + 9 * 4;
+    BOOST_CHECK (  rejected_entry ( b, bm_skip + 4 * 'Q', 8 ));
+    BOOST_CHECK (  rejected_entry ( b, bm_skip + 4 * 'Q', -2 ));
+    BOOST_CHECK ( !rejected_entry ( b, bm_skip + 4 * 'Q', 7 ));
+    BOOST_CHECK (  rejected_entry ( b, bmh_skip + 4 * 'Q', 0 ));
+    BOOST_CHECK (  rejected_entry ( b, bmh_skip + 4 * 'Q', 9 ));
+    BOOST_CHECK ( !rejected_entry ( b, bmh_skip + 4 * 'Q', 1 ));
+    BOOST_CHECK (  rejected_entry ( b, bm_suffix + 4 * 3, 0 ));
+    BOOST_CHECK (  rejected_entry ( b, bm_suffix + 4 * 8, 9 ));
+    BOOST_CHECK (  rejected_entry ( b, kmp, 0 ));
+    BOOST_CHECK (  rejected_entry ( b, kmp + 4 * 3, 3 ));
+    BOOST_CHECK (  rejected_entry ( b, kmp + 4 * 8, -2 ));
+    BOOST_CHECK ( !rejected_entry ( b, kmp + 4 * 8, -1 ));
+    BOOST_CHECK ( !rejected ( bytes, b.size ()));
+    }
+
+//  The mapped searchers work on any byte type, and take a 'Stats' policy
+    {
+    const char pat [] = "ANPANMAN";
+    const blob b ( vec ( pat, pat + 8 ));
+    const ba::searcher_tables tables ( b.data (), b.size ());
+    const std::string h ( "NOW AN ANPANMAN THE ANPANMANPANMAN" );
+    const std::vector<unsigned char> uh ( h.begin (), h.end ());
+    const ba::basic_mapped_knuth_morris_pratt<unsigned char> ukmp ( tables );
+    BOOST_CHECK ( ukmp ( uh.begin (), uh.end ()) == uh.begin () + 7 );
+
+    ba::basic_mapped_boyer_moore<char, ba::counting_search_stats> cbm ( tables );
+    std::vector<std::string::const_iterator> found;
+    cbm.find_all ( h.begin (), h.end (), std::back_inserter ( found ));
+    BOOST_CHECK_EQUAL ( found.size (), 3U );
+    BOOST_CHECK ( cbm.stats ().comparisons > 0 );
+    }
+    return 0;
+}
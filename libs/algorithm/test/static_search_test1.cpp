@@ -0,0 +1,133 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/static_boyer_moore.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if !defined(BOOST_NO_CXX14_CONSTEXPR) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+namespace ba = boost::algorithm;
+
+//  The tables are built at compile time
+typedef ba::static_boyer_moore<char, 'a', 'b', 'c', 'a', 'b'> abcab;
+BOOST_STATIC_ASSERT ( abcab::pattern_length == 5 );
+BOOST_STATIC_ASSERT ( abcab::tables.suffix [ 0 ] == 3 );
+BOOST_STATIC_ASSERT ( abcab::tables.bad_char ( 'a' ) == 3 );
+BOOST_STATIC_ASSERT ( abcab::tables.bad_char ( 'c' ) == 2 );
+BOOST_STATIC_ASSERT ( abcab::tables.bad_char ( 'z' ) == -1 );
+BOOST_STATIC_ASSERT ( ba::static_boyer_moore<wchar_t, L'x', L'y', L'x'>::tables.bad_char ( L'x' ) == 2 );
+
+namespace {
+
+//  Compare the static searcher with boyer_moore, built from the same pattern at runtime
+    template <typename Searcher, typename Container>
+    void check_one ( const Container &haystack ) {
+        typedef typename Container::const_iterator iter;
+        const Container needle ( Searcher::pattern, Searcher::pattern + Searcher::pattern_length );
+        const ba::boyer_moore<iter> bm ( needle.begin (), needle.end ());
+        const Searcher s;
+
+        BOOST_CHECK ( s ( haystack.begin (), haystack.end ()) == bm ( haystack.begin (), haystack.end ()));
+        BOOST_CHECK ( s ( haystack ) == bm ( haystack.begin (), haystack.end ()));
+
+        std::vector<iter> r1, r2;
+        s.find_all  ( haystack.begin (), haystack.end (), std::back_inserter ( r1 ));
+        bm.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( r2 ));
+        BOOST_CHECK ( r1 == r2 );
+
+        r1.clear ();
+        r2.clear ();
+        s.find_all  ( haystack.begin (), haystack.end (), std::back_inserter ( r1 ), false );
+        bm.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( r2 ), false );
+        BOOST_CHECK ( r1 == r2 );
+        }
+
+    template <typename Searcher, typename Container>
+    void check_all ( const std::vector<Container> &haystacks ) {
+        for ( std::size_t i = 0; i < haystacks.size (); ++i )
+            check_one<Searcher> ( haystacks [ i ] );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    std::vector<std::string> hs;
+    hs.push_back ( "" );
+    hs.push_back ( "a" );
+    hs.push_back ( "abcab" );
+    hs.push_back ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    hs.push_back ( "GET / HTTP/1.1\r\nHost: www.boost.org\r\n\r\nGET /x HTTP/1.0\r\n\r\n" );
+    hs.push_back ( std::string ( 100, 'a' ));
+    for ( int i = 0; i < 5; ++i )
+        hs.push_back ( make_corpus ( 3000, "abc", 3 ));
+    hs.push_back ( make_corpus ( 3000, "ab", 2 ));
+
+    check_all<ba::static_boyer_moore<char> > ( hs );
+    check_all<ba::static_boyer_moore<char, 'a'> > ( hs );
+    check_all<ba::static_boyer_moore<char, 'a', 'a', 'a'> > ( hs );
+    check_all<abcab> ( hs );
+    check_all<ba::static_boyer_moore<char, 'a', 'b', 'a', 'b', 'b'> > ( hs );
+    check_all<ba::static_boyer_moore<char, 'A', 'N', 'P', 'A', 'N', 'M', 'A', 'N'> > ( hs );
+    check_all<ba::static_boyer_moore<char, '\r', '\n', '\r', '\n'> > ( hs );
+    check_all<ba::static_boyer_moore<char, '\220', 'E', 'R'> > ( hs );
+//  Longer than the unroll limit
+    check_all<ba::static_boyer_moore<char,
+        'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a',
+        'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b',
+        'c', 'a', 'b', 'c', 'a'> > ( hs );
+    check_all<ba::static_boyer_moore<char,
+        'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a',
+        'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a',
+        'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a'> > ( hs );
+
+//  Wider element types
+    std::vector<std::wstring> ws;
+    ws.push_back ( L"" );
+    ws.push_back ( L"\x4e2d\x6587 text \x4e2d\x6587\x4e2d" );
+    std::wstring wbig;
+    for ( int i = 0; i < 2000; ++i )
+        wbig.push_back ( L"xyz\x4e2d" [ std::rand () % 4 ] );
+    ws.push_back ( wbig );
+    check_all<ba::static_boyer_moore<wchar_t, L'\x4e2d', L'\x6587'> > ( ws );
+    check_all<ba::static_boyer_moore<wchar_t, L'x', L'y', L'x'> > ( ws );
+    check_all<ba::static_boyer_moore<wchar_t, L'z', L'\x4e2d', L'z', L'x'> > ( ws );
+
+    std::vector<std::vector<int> > is;
+    std::vector<int> ibig;
+    for ( int i = 0; i < 2000; ++i )
+        ibig.push_back (( std::rand () % 3 ) * 1000000 - 1000000 );
+    is.push_back ( ibig );
+    check_all<ba::static_boyer_moore<int, 0, -1000000, 1000000> > ( is );
+    check_all<ba::static_boyer_moore<int, 0, 0, 0> > ( is );
+
+    const std::string get ( "xxGET / HTTP" );
+    BOOST_CHECK (( ba::static_boyer_moore_search<char, 'G', 'E', 'T'> ( get.begin (), get.end ()) == get.begin () + 2 ));
+    return 0;
+    }
+
+#else
+
+int test_main( int , char* [] )
+{
+    std::cout << "static_boyer_moore needs C++14 constexpr; not tested" << std::endl;
+    return 0;
+    }
+
+#endif
@@ -0,0 +1,110 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/stream_search.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef boost::uintmax_t position_type;
+    typedef std::vector<position_type> match_vec;
+
+//  The reference implementation: restart std::search after every match
+    match_vec naive_find_all ( const std::string &haystack, const std::string &needle, bool overlapping ) {
+        match_vec retVal;
+        std::string::const_iterator it = haystack.begin ();
+        while (( it = std::search ( it, haystack.end (), needle.begin (), needle.end ())) != haystack.end ()) {
+            retVal.push_back ( it - haystack.begin ());
+            if ( needle.empty ()) break;
+            it += overlapping ? 1 : needle.size ();
+            }
+        return retVal;
+        }
+
+//  Feed the haystack to the searchers in chunks of (up to) 'max_chunk' elements
+    void check_one ( const std::string &haystack, const std::string &needle, bool overlapping, std::size_t max_chunk ) {
+        typedef std::string::const_iterator str_iter;
+        const match_vec exp = naive_find_all ( haystack, needle, overlapping );
+
+        ba::knuth_morris_pratt_stream<str_iter>   kmp ( needle.begin (), needle.end (), overlapping );
+        ba::boyer_moore_horspool_stream<str_iter> bmh ( needle.begin (), needle.end (), overlapping );
+        match_vec r1, r2;
+        std::size_t pos = 0;
+        while ( pos < haystack.size ()) {
+            const std::size_t len = std::min<std::size_t> ( std::rand () % ( max_chunk + 1 ), haystack.size () - pos );
+        //  Each chunk lives in its own buffer, which goes away after the call
+            const std::vector<char> chunk ( haystack.begin () + pos, haystack.begin () + pos + len );
+            kmp.feed ( chunk.begin (), chunk.end (), std::back_inserter ( r1 ));
+            bmh.feed ( chunk.begin (), chunk.end (), std::back_inserter ( r2 ));
+            pos += len;
+            }
+
+        BOOST_CHECK ( r1 == exp );
+        BOOST_CHECK ( r2 == exp );
+        BOOST_CHECK_EQUAL ( kmp.position (), haystack.size ());
+        BOOST_CHECK_EQUAL ( bmh.position (), haystack.size ());
+
+    //  Start again, with the whole haystack as a single chunk
+        kmp.reset ();
+        bmh.reset ();
+        r1.clear ();
+        r2.clear ();
+        kmp.feed ( haystack.begin (), haystack.end (), std::back_inserter ( r1 ));
+        bmh.feed ( haystack.begin (), haystack.end (), std::back_inserter ( r2 ));
+        BOOST_CHECK ( r1 == exp );
+        BOOST_CHECK ( r2 == exp );
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        const std::size_t chunks [] = { 1, 2, 3, 5, 8, 13, 64 };
+        for ( std::size_t i = 0; i < sizeof ( chunks ) / sizeof ( chunks [ 0 ] ); ++i ) {
+            check_one ( haystack, needle, true,  chunks [ i ] );
+            check_one ( haystack, needle, false, chunks [ i ] );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, "ANPANMAN" );
+    check_one ( haystack1, "MAN THE" );
+    check_one ( haystack1, "NOW " );
+    check_one ( haystack1, "NEND" );
+    check_one ( haystack1, "NOT FOUND" );
+    check_one ( haystack1, "AN" );
+    check_one ( haystack1, "N" );
+    check_one ( haystack1, haystack1 );
+    check_one ( haystack1, "" );
+    check_one ( "", "abc" );
+
+    check_one ( std::string ( 50, 'a' ), "aaa" );
+    check_one ( "abababababababab", "abab" );
+
+    const std::string binary = make_corpus ( 1000, "ab", 2 );
+    for ( std::size_t len = 1; len <= 12; ++len )
+        for ( std::size_t i = 0; i < 4; ++i )
+            check_one ( binary, random_substr ( binary, len ));
+
+    std::cout << "Stream search tests complete" << std::endl;
+    return 0;
+    }
@@ -0,0 +1,165 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/suffix_array.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/mapped_corpus.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+
+//  The suffixes should be in (unsigned byte) order
+    bool suffix_less ( const std::string &s, std::size_t a, std::size_t b ) {
+        const int c = std::memcmp ( s.data () + a, s.data () + b, (std::min) ( s.size () - a, s.size () - b ));
+        return c != 0 ? c < 0 : a > b;
+        }
+
+    void check_sorted ( const std::string &corpus, const ba::suffix_array<str_iter> &sa ) {
+        BOOST_REQUIRE_EQUAL ( sa.size (), corpus.size ());
+        std::vector<bool> seen ( corpus.size ());
+        for ( std::size_t i = 0; i < sa.size (); ++i ) {
+            BOOST_REQUIRE ( sa.suffix ( i ) < corpus.size () && !seen [ sa.suffix ( i ) ] );
+            seen [ sa.suffix ( i ) ] = true;
+            if ( i > 0 )
+                BOOST_REQUIRE ( suffix_less ( corpus, sa.suffix ( i - 1 ), sa.suffix ( i )));
+            }
+        }
+
+//  The index should find what a searcher does
+    void check_query ( const std::string &corpus, const ba::suffix_array<str_iter> &sa, const std::string &needle ) {
+        std::vector<str_iter> exp, res;
+        ba::knuth_morris_pratt<str_iter> kmp ( needle.begin (), needle.end ());
+        kmp.find_all ( corpus.begin (), corpus.end (), std::back_inserter ( exp ));
+        sa.locate ( needle, std::back_inserter ( res ));
+        BOOST_CHECK ( res == exp );
+        BOOST_CHECK ( sa.find_first ( needle.begin (), needle.end ()) == kmp ( corpus.begin (), corpus.end ()));
+        if ( !needle.empty ())
+            BOOST_CHECK_EQUAL ( sa.count ( needle ), exp.size ());
+        }
+
+    void check_corpus ( const std::string &corpus ) {
+        const ba::suffix_array<str_iter> sa ( corpus.begin (), corpus.end ());
+        check_sorted ( corpus, sa );
+        for ( std::size_t len = 1; len <= 12 && len <= corpus.size (); len += 3 )
+            for ( std::size_t pos = 0; pos + len <= corpus.size (); pos += 1 + corpus.size () / 7 ) {
+                check_query ( corpus, sa, corpus.substr ( pos, len ));
+                std::string miss = corpus.substr ( pos, len );
+                miss [ len - 1 ] = 'z';
+                check_query ( corpus, sa, miss );
+                }
+        check_query ( corpus, sa, "" );
+        check_query ( corpus, sa, corpus );
+        check_query ( corpus, sa, corpus + "a" );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    check_corpus ( "" );
+    check_corpus ( "a" );
+    check_corpus ( "banana" );
+    check_corpus ( "mississippi" );
+    check_corpus ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_corpus ( std::string ( 100, 'a' ));
+    check_corpus ( "abababababababababababababababababab" );
+    check_corpus ( std::string ( "\0\0\001\0\377\377\0", 7 ));
+
+//  Random corpora, with small alphabets; lots of repeats, and deep recursion
+    for ( std::size_t len = 10; len < 5000; len *= 3 ) {
+        check_corpus ( make_corpus ( len, "ab", 2 ));
+        check_corpus ( make_corpus ( len, "ACGT", 4 ));
+        }
+    {
+    std::string fib = "a", prev = "b";
+    while ( fib.size () < 3000 ) {
+        const std::string next = fib + prev;
+        prev = fib;
+        fib = next;
+        }
+    check_corpus ( fib );
+    }
+
+//  Save the index, map it back in, and use it
+    {
+    const std::string corpus = make_corpus ( 20000, "ACGT", 4 );
+    const ba::suffix_array<str_iter> sa ( corpus.begin (), corpus.end ());
+    const char *k_file = "suffix_array_test1.index";
+    {
+    std::ofstream out ( k_file, std::ios_base::binary | std::ios_base::out );
+    sa.write ( out );
+    }
+    {
+    const ba::mapped_corpus mc ( k_file, ba::mapped_corpus::random_access );
+    const ba::suffix_array<str_iter> loaded ( corpus.begin (), corpus.end (), mc.begin (), mc.size ());
+    for ( std::size_t i = 0; i < sa.size (); ++i )
+        BOOST_REQUIRE_EQUAL ( loaded.suffix ( i ), sa.suffix ( i ));
+    check_query ( corpus, loaded, corpus.substr ( 1234, 9 ));
+    check_query ( corpus, loaded, "GATTACA" );
+
+    //  For a different corpus
+        BOOST_CHECK_THROW ( ba::suffix_array<str_iter> ( corpus.begin (), corpus.end () - 1, mc.begin (), mc.size ()),
+                            ba::suffix_array_error );
+    //  Truncated
+        BOOST_CHECK_THROW ( ba::suffix_array<str_iter> ( corpus.begin (), corpus.end (), mc.begin (), mc.size () - 4 ),
+                            ba::suffix_array_error );
+        BOOST_CHECK_THROW ( ba::suffix_array<str_iter> ( corpus.begin (), corpus.end (), mc.begin (), 16 ),
+                            ba::suffix_array_error );
+    }
+    std::remove ( k_file );
+
+    //  Damaged
+    std::ostringstream out ( std::ios_base::binary | std::ios_base::out );
+    sa.write ( out );
+    std::string blob = out.str ();
+    std::vector<boost::uint64_t> storage ( blob.size () / 8 + 1 );
+    blob [ 8 ] = 2;     // version
+    std::memcpy ( &storage [ 0 ], blob.data (), blob.size ());
+    BOOST_CHECK_THROW ( ba::suffix_array<str_iter> ( corpus.begin (), corpus.end (), &storage [ 0 ], blob.size ()),
+                        ba::suffix_array_error );
+    blob [ 8 ] = 1;
+    blob [ 0 ] = 'X';   // magic
+    std::memcpy ( &storage [ 0 ], blob.data (), blob.size ());
+    BOOST_CHECK_THROW ( ba::suffix_array<str_iter> ( corpus.begin (), corpus.end (), &storage [ 0 ], blob.size ()),
+                        ba::suffix_array_error );
+    blob [ 0 ] = 'B';
+    std::memcpy ( &storage [ 0 ], blob.data (), blob.size ());
+    BOOST_CHECK_NO_THROW ( ba::suffix_array<str_iter> ( corpus.begin (), corpus.end (), &storage [ 0 ], blob.size ()));
+
+    //  An entry past the end of the corpus
+    unsigned char *entries = reinterpret_cast<unsigned char *> ( &storage [ 0 ] ) + 32;
+    const boost::int32_t past_end = static_cast<boost::int32_t> ( corpus.size ());
+    std::memcpy ( entries + 4 * 500, &past_end, sizeof ( past_end ));
+    BOOST_CHECK_THROW ( ba::suffix_array<str_iter> ( corpus.begin (), corpus.end (), &storage [ 0 ], blob.size ()),
+                        ba::suffix_array_error );
+    const boost::int32_t negative = -1;
+    std::memcpy ( entries + 4 * 500, &negative, sizeof ( negative ));
+    BOOST_CHECK_THROW ( ba::suffix_array<str_iter> ( corpus.begin (), corpus.end (), &storage [ 0 ], blob.size ()),
+                        ba::suffix_array_error );
+    }
+    return 0;
+}
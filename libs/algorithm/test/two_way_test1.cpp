@@ -0,0 +1,153 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/two_way.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include "search_test_util.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  The reference implementation: restart std::search after every match
+    template <typename Container>
+    std::vector<std::size_t> naive_find_all ( const Container &haystack, const Container &needle, bool overlapping ) {
+        std::vector<std::size_t> retVal;
+        typename Container::const_iterator it = haystack.begin ();
+        while (( it = std::search ( it, haystack.end (), needle.begin (), needle.end ())) != haystack.end ()) {
+            retVal.push_back ( it - haystack.begin ());
+            if ( needle.empty ()) break;
+            it += overlapping ? 1 : needle.size ();
+            }
+        return retVal;
+        }
+
+    template <typename Container>
+    void check_mode ( const Container &haystack, const Container &needle, bool overlapping ) {
+        typedef typename Container::const_iterator iter;
+        const std::vector<std::size_t> exp = naive_find_all ( haystack, needle, overlapping );
+
+        std::vector<iter> res;
+        ba::two_way_find_all ( haystack.begin (), haystack.end (), needle.begin (), needle.end (),
+                                    std::back_inserter ( res ), overlapping );
+        BOOST_CHECK_EQUAL ( res.size (), exp.size ());
+        for ( std::size_t i = 0; i < res.size () && i < exp.size (); ++i )
+            BOOST_CHECK_EQUAL ( std::size_t ( res [ i ] - haystack.begin ()), exp [ i ] );
+        }
+
+    template <typename Container>
+    void check_one ( const Container &haystack, const Container &needle ) {
+        typedef typename Container::const_iterator iter;
+        const iter exp = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        const ba::two_way<iter> tw ( needle.begin (), needle.end ());
+        BOOST_CHECK ( tw ( haystack.begin (), haystack.end ()) == exp );
+        BOOST_CHECK ( tw ( haystack ) == exp );
+        BOOST_CHECK ( ba::two_way_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == exp );
+        check_mode ( haystack, needle, true );
+        check_mode ( haystack, needle, false );
+        }
+
+    std::vector<char> ReadFromFile ( const char *name ) {
+        std::ifstream in ( name, std::ios_base::binary | std::ios_base::in );
+        return std::vector<char> ( std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char> ());
+        }
+
+//  A character that counts the comparisons made with it
+    std::size_t comparisons = 0;
+    struct counted_char {
+        char c;
+        };
+    bool operator == ( counted_char a, counted_char b ) { ++comparisons; return a.c == b.c; }
+    bool operator <  ( counted_char a, counted_char b ) { return a.c < b.c; }
+
+    std::vector<counted_char> counted ( const std::string &s ) {
+        std::vector<counted_char> retVal ( s.size ());
+        for ( std::size_t i = 0; i < s.size (); ++i )
+            retVal [ i ].c = s [ i ];
+        return retVal;
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string haystack1 ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    check_one ( haystack1, std::string ( "ANPANMAN" ));
+    check_one ( haystack1, std::string ( "MAN THE" ));
+    check_one ( haystack1, std::string ( "NOW " ));
+    check_one ( haystack1, std::string ( "NEND" ));
+    check_one ( haystack1, std::string ( "NOT FOUND" ));
+    check_one ( haystack1, std::string ( "AN" ));
+    check_one ( haystack1, std::string ( "N" ));
+    check_one ( haystack1, haystack1 );
+    check_one ( haystack1, std::string ());
+    check_one ( std::string (), std::string ( "abc" ));
+
+//  Periodic patterns, and patterns that are almost periodic
+    check_one ( std::string ( 100, 'a' ), std::string ( "aaa" ));
+    check_one ( std::string ( "abababababababab" ), std::string ( "abab" ));
+    check_one ( std::string ( "aaaaaaaaaaaaaaaaaaaaab" ), std::string ( "aaaab" ));
+    check_one ( std::string ( "abaabaabaababaabaab" ), std::string ( "abaab" ));
+    check_one ( std::string ( "zzzzyzzzzzzyzzzz" ), std::string ( "zzzzy" ));
+    check_one ( std::string ( "aabaabaaabaabaab" ), std::string ( "aabaab" ));
+
+//  Every short pattern over small alphabets
+    const std::string binary = make_corpus ( 2000, "ab", 2 );
+    const std::string ternary = make_corpus ( 2000, "abc", 3 );
+    for ( std::size_t len = 1; len <= 16; ++len )
+        for ( std::size_t i = 0; i < 20; ++i ) {
+            check_one ( binary,  random_substr ( binary, len ));
+            check_one ( ternary, random_substr ( ternary, len ));
+            check_one ( binary,  make_corpus ( len, "ab", 2 ));
+            check_one ( ternary, make_corpus ( len, "abc", 3 ));
+            }
+
+//  The long patterns in data-files
+    const std::vector<char> c1 = ReadFromFile ( "data-files/0001.corpus" );
+    const char *patterns [] = {
+        "data-files/0001b.pat", "data-files/0001e.pat", "data-files/0001f.pat", "data-files/0001n.pat",
+        "data-files/0002b.pat", "data-files/0002e.pat", "data-files/0002f.pat", "data-files/0002n.pat" };
+    for ( std::size_t i = 0; i < sizeof ( patterns ) / sizeof ( patterns [ 0 ] ); ++i ) {
+        const std::vector<char> needle = ReadFromFile ( patterns [ i ] );
+        BOOST_CHECK ( ba::two_way_search ( c1.begin (), c1.end (), needle.begin (), needle.end ())
+                    == std::search ( c1.begin (), c1.end (), needle.begin (), needle.end ()));
+        }
+
+//  The number of comparisons is linear, even for the cases that are quadratic for BMH
+    const char *adversarial [][2] = {
+        { "a", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab" },
+        { "a", "baaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa" },
+        { "ab", "abababababababababababababababababababaab" },
+        { "a", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa" }
+        };
+    for ( std::size_t i = 0; i < sizeof ( adversarial ) / sizeof ( adversarial [ 0 ] ); ++i ) {
+        std::string hs;
+        while ( hs.size () < 100000 )
+            hs += adversarial [ i ][ 0 ];
+        const std::vector<counted_char> haystack = counted ( hs );
+        const std::vector<counted_char> needle = counted ( adversarial [ i ][ 1 ] );
+        comparisons = 0;
+        std::vector<std::vector<counted_char>::const_iterator> res;
+        ba::two_way_find_all ( haystack.begin (), haystack.end (), needle.begin (), needle.end (),
+                                    std::back_inserter ( res ));
+        BOOST_CHECK_LE ( comparisons, 2 * haystack.size ());
+        }
+
+    return 0;
+    }